@@ -0,0 +1,877 @@
+#ifndef ADAPTIVERADIXTREE_H
+#define ADAPTIVERADIXTREE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace DS {
+    /**
+     * @brief An adaptive radix tree (ART) ordered map for string and integer keys.
+     *
+     * Keys are treated as byte strings and consumed one byte per level. Inner nodes come
+     * in four sizes (4, 16, 48 and 256 children) and grow or shrink with their fan-out, so
+     * sparse levels stay small while dense levels get direct indexing. Node16 is searched
+     * with one SSE2 compare when available.
+     *
+     * Two techniques keep the tree shallow:
+     * - Path compression: a chain of single-child nodes is folded into a prefix stored in
+     *   the node below it. Up to max_prefix bytes are stored inline; longer prefixes are
+     *   skipped optimistically on lookup and verified against the leaf.
+     * - Lazy expansion: a leaf hangs directly below the first node where its key diverges
+     *   from all others, and stores its full key.
+     *
+     * A key that is a prefix of other keys is stored in the terminal slot of the node at
+     * which it ends, so arbitrary binary strings are supported.
+     *
+     * Integer keys are stored big-endian with the sign bit flipped, which makes byte order
+     * and numeric order agree. Iteration therefore visits integer keys in numeric order.
+     *
+     * @tparam K std::string or an integral type.
+     * @tparam V The type of the values.
+     */
+    template<typename K, typename V>
+    class AdaptiveRadixTree {
+        static_assert(std::is_same_v<K, std::string> || std::is_integral_v<K>,
+                      "AdaptiveRadixTree keys must be std::string or an integral type");
+
+        static constexpr std::uint32_t max_prefix = 10; ///< Prefix bytes stored inline in a node.
+
+        enum class NodeType : std::uint8_t { Leaf, Node4, Node16, Node48, Node256 };
+
+        struct Node {
+            NodeType type;
+
+            explicit Node(const NodeType type) : type(type) {}
+        };
+
+        struct Leaf : Node {
+            std::string key; ///< The full encoded key.
+            V value;
+
+            Leaf(const std::string_view key, const V &value) : Node(NodeType::Leaf), key(key), value(value) {}
+        };
+
+        struct Inner : Node {
+            std::uint16_t count = 0; ///< Number of children.
+            std::uint32_t prefix_len = 0; ///< Length of the compressed path above the children.
+            std::uint8_t prefix[max_prefix] = {}; ///< The first max_prefix bytes of the compressed path.
+            Leaf *terminal = nullptr; ///< The key that ends exactly at this node, if any.
+
+            explicit Inner(const NodeType type) : Node(type) {}
+        };
+
+        struct Node4 : Inner {
+            std::uint8_t keys[4] = {}; ///< Sorted child bytes.
+            Node *children[4] = {};
+
+            Node4() : Inner(NodeType::Node4) {}
+        };
+
+        struct Node16 : Inner {
+            alignas(16) std::uint8_t keys[16] = {}; ///< Sorted child bytes.
+            Node *children[16] = {};
+
+            Node16() : Inner(NodeType::Node16) {}
+        };
+
+        struct Node48 : Inner {
+            std::uint8_t index[256] = {}; ///< Slot + 1 of each byte's child, 0 if absent.
+            Node *children[48] = {};
+
+            Node48() : Inner(NodeType::Node48) {}
+        };
+
+        struct Node256 : Inner {
+            Node *children[256] = {};
+
+            Node256() : Inner(NodeType::Node256) {}
+        };
+
+        Node *root;
+        std::size_t size;
+
+        static std::string encode(const K &key) {
+            if constexpr (std::is_integral_v<K>) {
+                using U = std::make_unsigned_t<K>;
+                U bits = static_cast<U>(key);
+                if constexpr (std::is_signed_v<K>) bits ^= U(1) << (sizeof(K) * 8 - 1);
+
+                std::string bytes(sizeof(K), '\0');
+                for (std::size_t i = 0; i < sizeof(K); ++i) {
+                    bytes[i] = static_cast<char>(bits >> ((sizeof(K) - 1 - i) * 8));
+                }
+                return bytes;
+            } else {
+                return key;
+            }
+        }
+
+        static K decode(const std::string &bytes) {
+            if constexpr (std::is_integral_v<K>) {
+                using U = std::make_unsigned_t<K>;
+                U bits = 0;
+                for (std::size_t i = 0; i < sizeof(K); ++i) {
+                    bits = static_cast<U>((bits << 8) | static_cast<std::uint8_t>(bytes[i]));
+                }
+                if constexpr (std::is_signed_v<K>) bits ^= U(1) << (sizeof(K) * 8 - 1);
+                return static_cast<K>(bits);
+            } else {
+                return bytes;
+            }
+        }
+
+        static bool is_leaf(const Node *node) {
+            return node->type == NodeType::Leaf;
+        }
+
+        static std::uint8_t byte_at(const std::string_view key, const std::size_t depth) {
+            return static_cast<std::uint8_t>(key[depth]);
+        }
+
+        static void destroy(Node *node) {
+            if (node == nullptr) return;
+
+            switch (node->type) {
+                case NodeType::Leaf:
+                    delete static_cast<Leaf *>(node);
+                    return;
+                case NodeType::Node4: {
+                    auto *n = static_cast<Node4 *>(node);
+                    for (std::size_t i = 0; i < n->count; ++i) destroy(n->children[i]);
+                    delete n->terminal;
+                    delete n;
+                    return;
+                }
+                case NodeType::Node16: {
+                    auto *n = static_cast<Node16 *>(node);
+                    for (std::size_t i = 0; i < n->count; ++i) destroy(n->children[i]);
+                    delete n->terminal;
+                    delete n;
+                    return;
+                }
+                case NodeType::Node48: {
+                    auto *n = static_cast<Node48 *>(node);
+                    for (std::size_t i = 0; i < 48; ++i) destroy(n->children[i]);
+                    delete n->terminal;
+                    delete n;
+                    return;
+                }
+                case NodeType::Node256: {
+                    auto *n = static_cast<Node256 *>(node);
+                    for (std::size_t i = 0; i < 256; ++i) destroy(n->children[i]);
+                    delete n->terminal;
+                    delete n;
+                    return;
+                }
+            }
+        }
+
+        static int node16_find(const Node16 *node, const std::uint8_t byte) {
+#if defined(__SSE2__)
+            const __m128i matches = _mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(byte)),
+                                                   _mm_load_si128(reinterpret_cast<const __m128i *>(node->keys)));
+            const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(matches)) & ((1u << node->count) - 1);
+            return mask ? __builtin_ctz(mask) : -1;
+#else
+            for (int i = 0; i < node->count; ++i) {
+                if (node->keys[i] == byte) return i;
+            }
+            return -1;
+#endif
+        }
+
+        /**
+         * @brief Returns the slot that holds the child for the byte, or nullptr if there is none.
+         */
+        static Node **find_child(Inner *node, const std::uint8_t byte) {
+            switch (node->type) {
+                case NodeType::Node4: {
+                    auto *n = static_cast<Node4 *>(node);
+                    for (std::size_t i = 0; i < n->count; ++i) {
+                        if (n->keys[i] == byte) return &n->children[i];
+                    }
+                    return nullptr;
+                }
+                case NodeType::Node16: {
+                    auto *n = static_cast<Node16 *>(node);
+                    const int i = node16_find(n, byte);
+                    return i < 0 ? nullptr : &n->children[i];
+                }
+                case NodeType::Node48: {
+                    auto *n = static_cast<Node48 *>(node);
+                    return n->index[byte] ? &n->children[n->index[byte] - 1] : nullptr;
+                }
+                case NodeType::Node256: {
+                    auto *n = static_cast<Node256 *>(node);
+                    return n->children[byte] ? &n->children[byte] : nullptr;
+                }
+                default:
+                    return nullptr;
+            }
+        }
+
+        static void copy_header(Inner *to, const Inner *from) {
+            to->count = from->count;
+            to->prefix_len = from->prefix_len;
+            std::memcpy(to->prefix, from->prefix, max_prefix);
+            to->terminal = from->terminal;
+        }
+
+        /**
+         * @brief Inserts a sorted (byte, child) pair into the key/child arrays of a Node4 or Node16.
+         */
+        template<typename N>
+        static void insert_sorted(N *node, const std::uint8_t byte, Node *child) {
+            std::size_t pos = 0;
+            while (pos < node->count && node->keys[pos] < byte) ++pos;
+
+            std::memmove(node->keys + pos + 1, node->keys + pos, node->count - pos);
+            std::memmove(node->children + pos + 1, node->children + pos, (node->count - pos) * sizeof(Node *));
+            node->keys[pos] = byte;
+            node->children[pos] = child;
+            ++node->count;
+        }
+
+        /**
+         * @brief Adds a child for a byte that is not present yet, growing the node if it is full.
+         *
+         * @param ref The slot pointing at the node; updated if the node is replaced.
+         */
+        static void add_child(Node *&ref, Inner *node, const std::uint8_t byte, Node *child) {
+            switch (node->type) {
+                case NodeType::Node4: {
+                    auto *n = static_cast<Node4 *>(node);
+                    if (n->count < 4) {
+                        insert_sorted(n, byte, child);
+                        return;
+                    }
+
+                    auto *grown = new Node16();
+                    copy_header(grown, n);
+                    std::memcpy(grown->keys, n->keys, 4);
+                    std::memcpy(grown->children, n->children, 4 * sizeof(Node *));
+                    ref = grown;
+                    delete n;
+                    insert_sorted(grown, byte, child);
+                    return;
+                }
+                case NodeType::Node16: {
+                    auto *n = static_cast<Node16 *>(node);
+                    if (n->count < 16) {
+                        insert_sorted(n, byte, child);
+                        return;
+                    }
+
+                    auto *grown = new Node48();
+                    copy_header(grown, n);
+                    for (std::uint8_t i = 0; i < 16; ++i) {
+                        grown->children[i] = n->children[i];
+                        grown->index[n->keys[i]] = static_cast<std::uint8_t>(i + 1);
+                    }
+                    ref = grown;
+                    delete n;
+                    add_child(ref, grown, byte, child);
+                    return;
+                }
+                case NodeType::Node48: {
+                    auto *n = static_cast<Node48 *>(node);
+                    if (n->count < 48) {
+                        std::uint8_t slot = 0;
+                        while (n->children[slot] != nullptr) ++slot;
+                        n->children[slot] = child;
+                        n->index[byte] = static_cast<std::uint8_t>(slot + 1);
+                        ++n->count;
+                        return;
+                    }
+
+                    auto *grown = new Node256();
+                    copy_header(grown, n);
+                    for (std::size_t b = 0; b < 256; ++b) {
+                        if (n->index[b]) grown->children[b] = n->children[n->index[b] - 1];
+                    }
+                    ref = grown;
+                    delete n;
+                    add_child(ref, grown, byte, child);
+                    return;
+                }
+                case NodeType::Node256: {
+                    auto *n = static_cast<Node256 *>(node);
+                    n->children[byte] = child;
+                    ++n->count;
+                    return;
+                }
+                default:
+                    return;
+            }
+        }
+
+        /**
+         * @brief Folds a Node4 with a single child and no terminal into that child.
+         */
+        static void collapse(Node *&ref, Node4 *node) {
+            Node *child = node->children[0];
+
+            if (!is_leaf(child)) {
+                auto *inner = static_cast<Inner *>(child);
+                std::uint8_t merged[max_prefix];
+                std::uint32_t length = 0;
+
+                // Path of the child = path of the node + the child's byte + the child's own prefix.
+                const std::uint32_t stored = node->prefix_len < max_prefix ? node->prefix_len : max_prefix;
+                std::memcpy(merged, node->prefix, stored);
+                length = stored;
+                if (length < max_prefix) merged[length++] = node->keys[0];
+                for (std::uint32_t i = 0; length < max_prefix && i < inner->prefix_len && i < max_prefix; ++i) {
+                    merged[length++] = inner->prefix[i];
+                }
+
+                std::memcpy(inner->prefix, merged, length);
+                inner->prefix_len += node->prefix_len + 1;
+            }
+
+            ref = child;
+            delete node;
+        }
+
+        /**
+         * @brief Replaces an under-full node with a smaller one after a removal.
+         */
+        static void shrink(Node *&ref, Inner *node) {
+            switch (node->type) {
+                case NodeType::Node4: {
+                    auto *n = static_cast<Node4 *>(node);
+                    if (n->count == 0) {
+                        ref = n->terminal;
+                        delete n;
+                    } else if (n->count == 1 && n->terminal == nullptr) {
+                        collapse(ref, n);
+                    }
+                    return;
+                }
+                case NodeType::Node16: {
+                    auto *n = static_cast<Node16 *>(node);
+                    if (n->count > 3) return;
+
+                    auto *shrunk = new Node4();
+                    copy_header(shrunk, n);
+                    std::memcpy(shrunk->keys, n->keys, n->count);
+                    std::memcpy(shrunk->children, n->children, n->count * sizeof(Node *));
+                    ref = shrunk;
+                    delete n;
+                    return;
+                }
+                case NodeType::Node48: {
+                    auto *n = static_cast<Node48 *>(node);
+                    if (n->count > 12) return;
+
+                    auto *shrunk = new Node16();
+                    copy_header(shrunk, n);
+                    std::size_t pos = 0;
+                    for (std::size_t b = 0; b < 256; ++b) {
+                        if (!n->index[b]) continue;
+                        shrunk->keys[pos] = static_cast<std::uint8_t>(b);
+                        shrunk->children[pos++] = n->children[n->index[b] - 1];
+                    }
+                    ref = shrunk;
+                    delete n;
+                    return;
+                }
+                case NodeType::Node256: {
+                    auto *n = static_cast<Node256 *>(node);
+                    if (n->count > 37) return;
+
+                    auto *shrunk = new Node48();
+                    copy_header(shrunk, n);
+                    std::uint8_t slot = 0;
+                    for (std::size_t b = 0; b < 256; ++b) {
+                        if (n->children[b] == nullptr) continue;
+                        shrunk->children[slot] = n->children[b];
+                        shrunk->index[b] = ++slot;
+                    }
+                    ref = shrunk;
+                    delete n;
+                    return;
+                }
+                default:
+                    return;
+            }
+        }
+
+        static void remove_child(Inner *node, const std::uint8_t byte) {
+            switch (node->type) {
+                case NodeType::Node4: {
+                    auto *n = static_cast<Node4 *>(node);
+                    std::size_t pos = 0;
+                    while (n->keys[pos] != byte) ++pos;
+                    std::memmove(n->keys + pos, n->keys + pos + 1, n->count - pos - 1);
+                    std::memmove(n->children + pos, n->children + pos + 1, (n->count - pos - 1) * sizeof(Node *));
+                    break;
+                }
+                case NodeType::Node16: {
+                    auto *n = static_cast<Node16 *>(node);
+                    const auto pos = static_cast<std::size_t>(node16_find(n, byte));
+                    std::memmove(n->keys + pos, n->keys + pos + 1, n->count - pos - 1);
+                    std::memmove(n->children + pos, n->children + pos + 1, (n->count - pos - 1) * sizeof(Node *));
+                    break;
+                }
+                case NodeType::Node48: {
+                    auto *n = static_cast<Node48 *>(node);
+                    n->children[n->index[byte] - 1] = nullptr;
+                    n->index[byte] = 0;
+                    break;
+                }
+                case NodeType::Node256: {
+                    static_cast<Node256 *>(node)->children[byte] = nullptr;
+                    break;
+                }
+                default:
+                    return;
+            }
+            --node->count;
+        }
+
+        /**
+         * @brief Returns the leaf with the smallest key below a node.
+         */
+        static const Leaf *minimum(const Node *node) {
+            while (!is_leaf(node)) {
+                auto *inner = static_cast<const Inner *>(node);
+                if (inner->terminal != nullptr) return inner->terminal;
+
+                switch (node->type) {
+                    case NodeType::Node4:
+                        node = static_cast<const Node4 *>(node)->children[0];
+                        break;
+                    case NodeType::Node16:
+                        node = static_cast<const Node16 *>(node)->children[0];
+                        break;
+                    case NodeType::Node48: {
+                        auto *n = static_cast<const Node48 *>(node);
+                        std::size_t b = 0;
+                        while (!n->index[b]) ++b;
+                        node = n->children[n->index[b] - 1];
+                        break;
+                    }
+                    default: {
+                        auto *n = static_cast<const Node256 *>(node);
+                        std::size_t b = 0;
+                        while (n->children[b] == nullptr) ++b;
+                        node = n->children[b];
+                        break;
+                    }
+                }
+            }
+            return static_cast<const Leaf *>(node);
+        }
+
+        /**
+         * @brief Compares only the inline prefix bytes; used by the optimistic lookups.
+         * @return true if the stored bytes match the key.
+         */
+        static bool check_prefix(const Inner *node, const std::string_view key, const std::size_t depth) {
+            const std::size_t stored = node->prefix_len < max_prefix ? node->prefix_len : max_prefix;
+            if (depth + stored > key.size()) return false;
+            return std::memcmp(node->prefix, key.data() + depth, stored) == 0;
+        }
+
+        /**
+         * @brief Counts how many bytes of the node's full prefix match the key.
+         *
+         * Bytes beyond the inline prefix are read from a leaf below the node.
+         */
+        static std::size_t prefix_mismatch(const Inner *node, const std::string_view key, const std::size_t depth) {
+            const std::size_t remaining = key.size() - depth;
+            const std::size_t stored = node->prefix_len < max_prefix ? node->prefix_len : max_prefix;
+            std::size_t index = 0;
+
+            for (; index < stored && index < remaining; ++index) {
+                if (node->prefix[index] != byte_at(key, depth + index)) return index;
+            }
+
+            if (node->prefix_len > max_prefix) {
+                const std::string &full = minimum(node)->key;
+                for (; index < node->prefix_len && index < remaining; ++index) {
+                    if (static_cast<std::uint8_t>(full[depth + index]) != byte_at(key, depth + index)) return index;
+                }
+            }
+
+            return index;
+        }
+
+        /**
+         * @brief Places a leaf below a node: in its terminal slot if the key ends here, as a child otherwise.
+         */
+        static void attach_leaf(Node *&ref, Inner *node, Leaf *leaf, const std::size_t depth) {
+            if (leaf->key.size() == depth) {
+                node->terminal = leaf;
+            } else {
+                add_child(ref, node, byte_at(leaf->key, depth), leaf);
+            }
+        }
+
+        bool insert_recursive(Node *&ref, const std::string_view key, std::size_t depth, const V &value,
+                              const bool assign) {
+            Node *node = ref;
+
+            if (node == nullptr) {
+                ref = new Leaf(key, value);
+                return true;
+            }
+
+            if (is_leaf(node)) {
+                auto *leaf = static_cast<Leaf *>(node);
+                if (leaf->key == key) {
+                    if (assign) leaf->value = value;
+                    return false;
+                }
+
+                // Expand the lazily placed leaf into a Node4 holding both keys.
+                std::size_t common = 0;
+                while (depth + common < key.size() && depth + common < leaf->key.size() &&
+                       key[depth + common] == leaf->key[depth + common]) {
+                    ++common;
+                }
+
+                auto *split = new Node4();
+                split->prefix_len = static_cast<std::uint32_t>(common);
+                std::memcpy(split->prefix, key.data() + depth, common < max_prefix ? common : max_prefix);
+
+                ref = split;
+                attach_leaf(ref, split, leaf, depth + common);
+                attach_leaf(ref, split, new Leaf(key, value), depth + common);
+                return true;
+            }
+
+            auto *inner = static_cast<Inner *>(node);
+
+            if (inner->prefix_len > 0) {
+                const std::size_t matched = prefix_mismatch(inner, key, depth);
+
+                if (matched < inner->prefix_len) {
+                    // The key leaves the compressed path part way: split the path at the mismatch.
+                    auto *split = new Node4();
+                    split->prefix_len = static_cast<std::uint32_t>(matched);
+                    std::memcpy(split->prefix, key.data() + depth, matched < max_prefix ? matched : max_prefix);
+                    ref = split;
+
+                    if (inner->prefix_len <= max_prefix) {
+                        const std::uint8_t byte = inner->prefix[matched];
+                        inner->prefix_len -= static_cast<std::uint32_t>(matched + 1);
+                        std::memmove(inner->prefix, inner->prefix + matched + 1, inner->prefix_len);
+                        add_child(ref, split, byte, inner);
+                    } else {
+                        inner->prefix_len -= static_cast<std::uint32_t>(matched + 1);
+                        const std::string &full = minimum(inner)->key;
+                        const std::size_t stored = inner->prefix_len < max_prefix ? inner->prefix_len : max_prefix;
+                        add_child(ref, split, static_cast<std::uint8_t>(full[depth + matched]), inner);
+                        std::memcpy(inner->prefix, full.data() + depth + matched + 1, stored);
+                    }
+
+                    attach_leaf(ref, split, new Leaf(key, value), depth + matched);
+                    return true;
+                }
+
+                depth += inner->prefix_len;
+            }
+
+            if (depth == key.size()) {
+                if (inner->terminal != nullptr) {
+                    if (assign) inner->terminal->value = value;
+                    return false;
+                }
+                inner->terminal = new Leaf(key, value);
+                return true;
+            }
+
+            if (Node **child = find_child(inner, byte_at(key, depth))) {
+                return insert_recursive(*child, key, depth + 1, value, assign);
+            }
+
+            add_child(ref, inner, byte_at(key, depth), new Leaf(key, value));
+            return true;
+        }
+
+        bool erase_recursive(Node *&ref, const std::string_view key, std::size_t depth) {
+            Node *node = ref;
+            if (node == nullptr) return false;
+
+            if (is_leaf(node)) {
+                // Only reached for a leaf at the root; deeper leaves are removed by their parent.
+                auto *leaf = static_cast<Leaf *>(node);
+                if (leaf->key != key) return false;
+                delete leaf;
+                ref = nullptr;
+                return true;
+            }
+
+            auto *inner = static_cast<Inner *>(node);
+            if (!check_prefix(inner, key, depth)) return false;
+            depth += inner->prefix_len;
+            if (depth > key.size()) return false;
+
+            if (depth == key.size()) {
+                if (inner->terminal == nullptr || inner->terminal->key != key) return false;
+                delete inner->terminal;
+                inner->terminal = nullptr;
+                shrink(ref, inner);
+                return true;
+            }
+
+            Node **child = find_child(inner, byte_at(key, depth));
+            if (child == nullptr) return false;
+
+            if (is_leaf(*child)) {
+                auto *leaf = static_cast<Leaf *>(*child);
+                if (leaf->key != key) return false;
+                remove_child(inner, byte_at(key, depth));
+                delete leaf;
+                shrink(ref, inner);
+                return true;
+            }
+
+            return erase_recursive(*child, key, depth + 1);
+        }
+
+        template<typename F>
+        static void for_each_recursive(Node *node, F &fn) {
+            if (node == nullptr) return;
+
+            if (is_leaf(node)) {
+                auto *leaf = static_cast<Leaf *>(node);
+                fn(decode(leaf->key), leaf->value);
+                return;
+            }
+
+            auto *inner = static_cast<Inner *>(node);
+            // A key that ends at this node is a prefix of every key below it, so it sorts first.
+            if (inner->terminal != nullptr) fn(decode(inner->terminal->key), inner->terminal->value);
+
+            switch (node->type) {
+                case NodeType::Node4: {
+                    auto *n = static_cast<Node4 *>(node);
+                    for (std::size_t i = 0; i < n->count; ++i) for_each_recursive(n->children[i], fn);
+                    break;
+                }
+                case NodeType::Node16: {
+                    auto *n = static_cast<Node16 *>(node);
+                    for (std::size_t i = 0; i < n->count; ++i) for_each_recursive(n->children[i], fn);
+                    break;
+                }
+                case NodeType::Node48: {
+                    auto *n = static_cast<Node48 *>(node);
+                    for (std::size_t b = 0; b < 256; ++b) {
+                        if (n->index[b]) for_each_recursive(n->children[n->index[b] - 1], fn);
+                    }
+                    break;
+                }
+                default: {
+                    auto *n = static_cast<Node256 *>(node);
+                    for (std::size_t b = 0; b < 256; ++b) for_each_recursive(n->children[b], fn);
+                    break;
+                }
+            }
+        }
+
+        V *find_encoded(const std::string_view key) const {
+            Node *node = root;
+            std::size_t depth = 0;
+
+            while (node != nullptr) {
+                if (is_leaf(node)) {
+                    auto *leaf = static_cast<Leaf *>(node);
+                    return leaf->key == key ? &leaf->value : nullptr;
+                }
+
+                auto *inner = static_cast<Inner *>(node);
+                if (!check_prefix(inner, key, depth)) return nullptr;
+                depth += inner->prefix_len;
+                if (depth > key.size()) return nullptr;
+
+                if (depth == key.size()) {
+                    Leaf *terminal = inner->terminal;
+                    return terminal != nullptr && terminal->key == key ? &terminal->value : nullptr;
+                }
+
+                Node **child = find_child(inner, byte_at(key, depth));
+                node = child != nullptr ? *child : nullptr;
+                ++depth;
+            }
+
+            return nullptr;
+        }
+
+    public:
+        /**
+         * @brief Constructs an empty tree.
+         */
+        explicit AdaptiveRadixTree() : root(nullptr), size(0) {}
+
+        AdaptiveRadixTree(const AdaptiveRadixTree &) = delete;
+
+        AdaptiveRadixTree &operator=(const AdaptiveRadixTree &) = delete;
+
+        /**
+         * @brief Destructor that frees every node and leaf.
+         */
+        ~AdaptiveRadixTree() {
+            clear();
+        }
+
+        /**
+         * @brief Checks if the tree is empty.
+         * @return true if the tree holds no keys, false otherwise.
+         */
+        bool empty() const noexcept {
+            return size == 0;
+        }
+
+        /**
+         * @brief Retrieves the number of keys in the tree.
+         * @return The number of keys.
+         */
+        std::size_t get_size() const noexcept {
+            return size;
+        }
+
+        /**
+         * @brief Inserts a key/value pair if the key is not present yet.
+         * @param key The key to insert.
+         * @param value The value to associate with the key.
+         * @return true if the pair was inserted, false if the key already existed (its value is left unchanged).
+         */
+        bool insert(const K &key, const V &value) {
+            const bool inserted = insert_recursive(root, encode(key), 0, value, false);
+            if (inserted) ++size;
+            return inserted;
+        }
+
+        /**
+         * @brief Inserts a key/value pair, or replaces the value if the key is already present.
+         * @param key The key to insert.
+         * @param value The value to associate with the key.
+         * @return true if the key was inserted, false if an existing value was replaced.
+         */
+        bool insert_or_assign(const K &key, const V &value) {
+            const bool inserted = insert_recursive(root, encode(key), 0, value, true);
+            if (inserted) ++size;
+            return inserted;
+        }
+
+        /**
+         * @brief Removes a key and its value.
+         * @param key The key to remove.
+         * @return true if the key was found and removed, false otherwise.
+         */
+        bool erase(const K &key) {
+            const bool erased = erase_recursive(root, encode(key), 0);
+            if (erased) --size;
+            return erased;
+        }
+
+        /**
+         * @brief Finds the value stored for a key.
+         * @param key The key to search for.
+         * @return A pointer to the value if found, nullptr otherwise.
+         */
+        V *find(const K &key) const {
+            return find_encoded(encode(key));
+        }
+
+        /**
+         * @brief Checks whether a key is in the tree.
+         * @param key The key to search for.
+         * @return true if the key is present, false otherwise.
+         */
+        bool contains(const K &key) const {
+            return find(key) != nullptr;
+        }
+
+        /**
+         * @brief Calls a function for every key/value pair in key order.
+         * @param fn A callable invoked as fn(const K &key, V &value).
+         */
+        template<typename F>
+        void for_each(F &&fn) const {
+            for_each_recursive(root, fn);
+        }
+
+        /**
+         * @brief Calls a function, in key order, for every key that starts with the given bytes.
+         *
+         * For integer keys the prefix is matched against the big-endian encoding, so a
+         * prefix of the high-order bytes selects an aligned numeric range.
+         *
+         * @param prefix The byte prefix to match.
+         * @param fn A callable invoked as fn(const K &key, V &value).
+         */
+        template<typename F>
+        void for_each_prefix(const std::string_view prefix, F &&fn) const {
+            Node *node = root;
+            std::size_t depth = 0;
+
+            while (node != nullptr) {
+                if (is_leaf(node)) {
+                    auto *leaf = static_cast<Leaf *>(node);
+                    if (leaf->key.compare(0, prefix.size(), prefix) == 0) fn(decode(leaf->key), leaf->value);
+                    return;
+                }
+
+                if (depth == prefix.size()) break;
+
+                auto *inner = static_cast<Inner *>(node);
+                if (inner->prefix_len > 0) {
+                    const std::size_t remaining = prefix.size() - depth;
+                    const std::size_t needed = inner->prefix_len < remaining ? inner->prefix_len : remaining;
+                    if (prefix_mismatch(inner, prefix, depth) < needed) return;
+
+                    // The prefix ends inside the compressed path: the whole subtree matches.
+                    if (inner->prefix_len >= remaining) break;
+                    depth += inner->prefix_len;
+                }
+
+                Node **child = find_child(inner, byte_at(prefix, depth));
+                node = child != nullptr ? *child : nullptr;
+                ++depth;
+            }
+
+            for_each_recursive(node, fn);
+        }
+
+        /**
+         * @brief Removes every key and frees all nodes.
+         */
+        void clear() {
+            destroy(root);
+            root = nullptr;
+            size = 0;
+        }
+
+        /**
+         * @brief Displays the contents of the tree in key order.
+         * @remark Only works when both K and V can be written to std::ostream.
+         */
+        void show() const {
+            std::cout << "{";
+
+            bool first = true;
+            for_each([&first](const K &key, const V &value) {
+                if (!first) std::cout << ", ";
+                std::cout << key << ": " << value;
+                first = false;
+            });
+
+            std::cout << "}\n";
+        }
+    };
+} // DS
+
+#endif //ADAPTIVERADIXTREE_H
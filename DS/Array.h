@@ -108,6 +108,22 @@ namespace DS {
             return _size;
         }
 
+        T *begin() {
+            return _array;
+        }
+
+        T *end() {
+            return _array + _size;
+        }
+
+        const T *begin() const {
+            return _array;
+        }
+
+        const T *end() const {
+            return _array + _size;
+        }
+
         void resize(const int new_capacity) {
             if (!is_valid_capacity(new_capacity)) throw std::runtime_error("Invalid capacity argument");
             if (new_capacity == _capacity) return;
@@ -0,0 +1,750 @@
+#ifndef BPLUSTREE_H
+#define BPLUSTREE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace DS {
+    /**
+     * @brief An in-memory B+tree ordered map.
+     *
+     * All key/value pairs live in the leaves, which are linked in key order so that range
+     * scans walk contiguous arrays instead of chasing one pointer per element. The key
+     * array of every node is NodeBytes long, a multiple of the cache line size, and the
+     * values are kept apart from the keys so that searching a node only touches key lines.
+     *
+     * Searching inside a node is branchless for arbitrary keys and uses AVX2 compares for
+     * 32- and 64-bit signed integer keys when the compiler targets AVX2.
+     *
+     * @tparam K The type of the keys. Must be default constructible and ordered by operator<.
+     * @tparam V The type of the values. Must be default constructible.
+     * @tparam NodeBytes The size of a node's key array in bytes.
+     */
+    template<typename K, typename V, std::size_t NodeBytes = 256>
+    class BPlusTree {
+        static_assert(NodeBytes % 64 == 0, "NodeBytes must be a multiple of the cache line size");
+
+        static constexpr std::size_t capacity = NodeBytes / sizeof(K) < 4 ? 4 : NodeBytes / sizeof(K);
+        static constexpr std::size_t min_keys = (capacity - 1) / 2; ///< Occupancy below which a node is rebalanced.
+
+        struct alignas(64) Node {
+            K keys[capacity]; ///< Sorted keys; in inner nodes keys[i] separates children[i] and children[i + 1].
+            std::uint16_t count = 0; ///< Number of keys in use.
+            bool leaf;
+
+            explicit Node(const bool leaf) : keys(), leaf(leaf) {}
+        };
+
+        struct Leaf : Node {
+            V values[capacity];
+            Leaf *prev = nullptr;
+            Leaf *next = nullptr;
+
+            Leaf() : Node(true), values() {}
+        };
+
+        struct Inner : Node {
+            Node *children[capacity + 1];
+
+            Inner() : Node(false), children() {}
+        };
+
+        struct Split {
+            K key; ///< Smallest key of the new right node.
+            Node *right = nullptr; ///< New right sibling, or nullptr if no split happened.
+        };
+
+        Node *root;
+        Leaf *first; ///< Leftmost leaf, where iteration starts.
+        std::size_t size;
+
+        static bool equal(const K &a, const K &b) {
+            return !(a < b) && !(b < a);
+        }
+
+        /**
+         * @brief Counts the keys that are less than (lower) or not greater than (upper) the key.
+         */
+        template<bool Upper>
+        static std::size_t search(const K *keys, const std::size_t n, const K &key) {
+#if defined(__AVX2__)
+            if constexpr (std::is_same_v<K, std::int32_t> || std::is_same_v<K, std::int64_t>) {
+                constexpr std::size_t lanes = 32 / sizeof(K);
+                const __m256i needle = sizeof(K) == 4 ? _mm256_set1_epi32(static_cast<int>(key))
+                                                      : _mm256_set1_epi64x(static_cast<long long>(key));
+                std::size_t result = 0;
+
+                for (std::size_t i = 0; i < n; i += lanes) {
+                    const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys + i));
+                    __m256i hits;
+                    if constexpr (sizeof(K) == 4) {
+                        hits = Upper ? _mm256_xor_si256(_mm256_cmpgt_epi32(block, needle), _mm256_set1_epi32(-1))
+                                     : _mm256_cmpgt_epi32(needle, block);
+                    } else {
+                        hits = Upper ? _mm256_xor_si256(_mm256_cmpgt_epi64(block, needle), _mm256_set1_epi64x(-1))
+                                     : _mm256_cmpgt_epi64(needle, block);
+                    }
+
+                    const std::size_t valid = n - i < lanes ? n - i : lanes;
+                    const unsigned mask = static_cast<unsigned>(
+                        sizeof(K) == 4 ? _mm256_movemask_ps(_mm256_castsi256_ps(hits))
+                                       : _mm256_movemask_pd(_mm256_castsi256_pd(hits))) & ((1u << valid) - 1);
+                    result += static_cast<std::size_t>(__builtin_popcount(mask));
+                    if (mask != (1u << valid) - 1) break; // Keys are sorted: no hits past the first miss.
+                }
+
+                return result;
+            }
+#endif
+            if (n == 0) return 0;
+
+            const K *base = keys;
+            std::size_t length = n;
+
+            while (length > 1) {
+                const std::size_t half = length / 2;
+                const bool right = Upper ? !(key < base[half - 1]) : base[half - 1] < key;
+                base = right ? base + half : base;
+                length -= half;
+            }
+
+            return static_cast<std::size_t>(base - keys) + (Upper ? !(key < *base) : *base < key);
+        }
+
+        static std::size_t lower(const Node *node, const K &key) {
+            return search<false>(node->keys, node->count, key);
+        }
+
+        static std::size_t upper(const Node *node, const K &key) {
+            return search<true>(node->keys, node->count, key);
+        }
+
+        static void destroy(Node *node) {
+            if (node == nullptr) return;
+
+            if (node->leaf) {
+                delete static_cast<Leaf *>(node);
+            } else {
+                auto *inner = static_cast<Inner *>(node);
+                for (std::size_t i = 0; i <= inner->count; ++i) destroy(inner->children[i]);
+                delete inner;
+            }
+        }
+
+        /**
+         * @brief Descends to the leaf that would hold the key.
+         */
+        Leaf *find_leaf(const K &key) const {
+            Node *node = root;
+            while (!node->leaf) {
+                node = static_cast<Inner *>(node)->children[upper(node, key)];
+            }
+            return static_cast<Leaf *>(node);
+        }
+
+        bool insert_into_leaf(Leaf *leaf, const K &key, const V &value, const bool assign, Split &split) {
+            std::size_t pos = lower(leaf, key);
+
+            if (pos < leaf->count && equal(leaf->keys[pos], key)) {
+                if (assign) leaf->values[pos] = value;
+                return false;
+            }
+
+            Leaf *target = leaf;
+
+            if (leaf->count == capacity) {
+                auto *right = new Leaf();
+                const std::size_t keep = capacity / 2;
+
+                for (std::size_t i = keep; i < capacity; ++i) {
+                    right->keys[i - keep] = std::move(leaf->keys[i]);
+                    right->values[i - keep] = std::move(leaf->values[i]);
+                }
+                right->count = static_cast<std::uint16_t>(capacity - keep);
+                leaf->count = static_cast<std::uint16_t>(keep);
+
+                right->next = leaf->next;
+                right->prev = leaf;
+                if (leaf->next != nullptr) leaf->next->prev = right;
+                leaf->next = right;
+
+                if (pos > keep) {
+                    target = right;
+                    pos -= keep;
+                }
+
+                split.right = right;
+            }
+
+            for (std::size_t i = target->count; i > pos; --i) {
+                target->keys[i] = std::move(target->keys[i - 1]);
+                target->values[i] = std::move(target->values[i - 1]);
+            }
+            target->keys[pos] = key;
+            target->values[pos] = value;
+            ++target->count;
+
+            if (split.right != nullptr) split.key = split.right->keys[0];
+            return true;
+        }
+
+        /**
+         * @brief Inserts a separator and its right child at position pos, splitting the node if it is full.
+         */
+        static void insert_into_inner(Inner *node, const std::size_t pos, const Split &child, Split &split) {
+            if (node->count < capacity) {
+                for (std::size_t i = node->count; i > pos; --i) {
+                    node->keys[i] = std::move(node->keys[i - 1]);
+                    node->children[i + 1] = node->children[i];
+                }
+                node->keys[pos] = child.key;
+                node->children[pos + 1] = child.right;
+                ++node->count;
+                return;
+            }
+
+            // Lay out the capacity + 1 keys and capacity + 2 children in order, then cut in the middle.
+            K keys[capacity + 1];
+            Node *children[capacity + 2];
+
+            for (std::size_t i = 0, j = 0; i <= capacity; ++i) {
+                keys[i] = i == pos ? child.key : std::move(node->keys[j++]);
+            }
+            for (std::size_t i = 0, j = 0; i <= capacity + 1; ++i) {
+                children[i] = i == pos + 1 ? child.right : node->children[j++];
+            }
+
+            const std::size_t left_count = (capacity + 1) / 2;
+            auto *right = new Inner();
+
+            for (std::size_t i = 0; i < left_count; ++i) {
+                node->keys[i] = std::move(keys[i]);
+                node->children[i] = children[i];
+            }
+            node->children[left_count] = children[left_count];
+            node->count = static_cast<std::uint16_t>(left_count);
+
+            for (std::size_t i = left_count + 1; i <= capacity; ++i) {
+                right->keys[i - left_count - 1] = std::move(keys[i]);
+                right->children[i - left_count - 1] = children[i];
+            }
+            right->children[capacity - left_count] = children[capacity + 1];
+            right->count = static_cast<std::uint16_t>(capacity - left_count);
+
+            split.key = std::move(keys[left_count]);
+            split.right = right;
+        }
+
+        bool insert_recursive(Node *node, const K &key, const V &value, const bool assign, Split &split) {
+            if (node->leaf) {
+                return insert_into_leaf(static_cast<Leaf *>(node), key, value, assign, split);
+            }
+
+            auto *inner = static_cast<Inner *>(node);
+            const std::size_t index = upper(inner, key);
+            Split child;
+            const bool inserted = insert_recursive(inner->children[index], key, value, assign, child);
+
+            if (child.right != nullptr) {
+                insert_into_inner(inner, index, child, split);
+            }
+
+            return inserted;
+        }
+
+        bool insert_impl(const K &key, const V &value, const bool assign) {
+            if (root == nullptr) {
+                first = new Leaf();
+                root = first;
+            }
+
+            Split split;
+            const bool inserted = insert_recursive(root, key, value, assign, split);
+
+            if (split.right != nullptr) {
+                auto *new_root = new Inner();
+                new_root->keys[0] = split.key;
+                new_root->children[0] = root;
+                new_root->children[1] = split.right;
+                new_root->count = 1;
+                root = new_root;
+            }
+
+            if (inserted) ++size;
+            return inserted;
+        }
+
+        /**
+         * @brief Merges children[index + 1] of the parent into children[index].
+         */
+        static void merge_children(Inner *parent, const std::size_t index) {
+            Node *left = parent->children[index];
+            Node *right = parent->children[index + 1];
+
+            if (left->leaf) {
+                auto *left_leaf = static_cast<Leaf *>(left);
+                auto *right_leaf = static_cast<Leaf *>(right);
+
+                for (std::size_t i = 0; i < right_leaf->count; ++i) {
+                    left_leaf->keys[left_leaf->count + i] = std::move(right_leaf->keys[i]);
+                    left_leaf->values[left_leaf->count + i] = std::move(right_leaf->values[i]);
+                }
+                left_leaf->count = static_cast<std::uint16_t>(left_leaf->count + right_leaf->count);
+
+                left_leaf->next = right_leaf->next;
+                if (right_leaf->next != nullptr) right_leaf->next->prev = left_leaf;
+                delete right_leaf;
+            } else {
+                auto *left_inner = static_cast<Inner *>(left);
+                auto *right_inner = static_cast<Inner *>(right);
+
+                left_inner->keys[left_inner->count] = std::move(parent->keys[index]);
+                for (std::size_t i = 0; i < right_inner->count; ++i) {
+                    left_inner->keys[left_inner->count + 1 + i] = std::move(right_inner->keys[i]);
+                }
+                for (std::size_t i = 0; i <= right_inner->count; ++i) {
+                    left_inner->children[left_inner->count + 1 + i] = right_inner->children[i];
+                }
+                left_inner->count = static_cast<std::uint16_t>(left_inner->count + 1 + right_inner->count);
+                delete right_inner;
+            }
+
+            for (std::size_t i = index; i + 1 < parent->count; ++i) {
+                parent->keys[i] = std::move(parent->keys[i + 1]);
+                parent->children[i + 1] = parent->children[i + 2];
+            }
+            --parent->count;
+        }
+
+        /**
+         * @brief Restores the minimum occupancy of children[index] by borrowing from or merging with a sibling.
+         */
+        static void rebalance(Inner *parent, const std::size_t index) {
+            Node *node = parent->children[index];
+            Node *left = index > 0 ? parent->children[index - 1] : nullptr;
+            Node *right = index < parent->count ? parent->children[index + 1] : nullptr;
+
+            if (left != nullptr && left->count > min_keys) {
+                if (node->leaf) {
+                    auto *leaf = static_cast<Leaf *>(node);
+                    auto *donor = static_cast<Leaf *>(left);
+
+                    for (std::size_t i = leaf->count; i > 0; --i) {
+                        leaf->keys[i] = std::move(leaf->keys[i - 1]);
+                        leaf->values[i] = std::move(leaf->values[i - 1]);
+                    }
+                    leaf->keys[0] = std::move(donor->keys[donor->count - 1]);
+                    leaf->values[0] = std::move(donor->values[donor->count - 1]);
+                    parent->keys[index - 1] = leaf->keys[0];
+                } else {
+                    auto *inner = static_cast<Inner *>(node);
+                    auto *donor = static_cast<Inner *>(left);
+
+                    for (std::size_t i = inner->count; i > 0; --i) {
+                        inner->keys[i] = std::move(inner->keys[i - 1]);
+                    }
+                    for (std::size_t i = inner->count + 1; i > 0; --i) {
+                        inner->children[i] = inner->children[i - 1];
+                    }
+                    inner->keys[0] = std::move(parent->keys[index - 1]);
+                    inner->children[0] = donor->children[donor->count];
+                    parent->keys[index - 1] = std::move(donor->keys[donor->count - 1]);
+                }
+                ++node->count;
+                --left->count;
+                return;
+            }
+
+            if (right != nullptr && right->count > min_keys) {
+                if (node->leaf) {
+                    auto *leaf = static_cast<Leaf *>(node);
+                    auto *donor = static_cast<Leaf *>(right);
+
+                    leaf->keys[leaf->count] = std::move(donor->keys[0]);
+                    leaf->values[leaf->count] = std::move(donor->values[0]);
+                    for (std::size_t i = 0; i + 1 < donor->count; ++i) {
+                        donor->keys[i] = std::move(donor->keys[i + 1]);
+                        donor->values[i] = std::move(donor->values[i + 1]);
+                    }
+                    parent->keys[index] = donor->keys[0];
+                } else {
+                    auto *inner = static_cast<Inner *>(node);
+                    auto *donor = static_cast<Inner *>(right);
+
+                    inner->keys[inner->count] = std::move(parent->keys[index]);
+                    inner->children[inner->count + 1] = donor->children[0];
+                    parent->keys[index] = std::move(donor->keys[0]);
+                    for (std::size_t i = 0; i + 1 < donor->count; ++i) {
+                        donor->keys[i] = std::move(donor->keys[i + 1]);
+                    }
+                    for (std::size_t i = 0; i < donor->count; ++i) {
+                        donor->children[i] = donor->children[i + 1];
+                    }
+                }
+                ++node->count;
+                --right->count;
+                return;
+            }
+
+            if (left != nullptr) {
+                merge_children(parent, index - 1);
+            } else {
+                merge_children(parent, index);
+            }
+        }
+
+        bool erase_recursive(Node *node, const K &key) {
+            if (node->leaf) {
+                auto *leaf = static_cast<Leaf *>(node);
+                const std::size_t pos = lower(leaf, key);
+                if (pos >= leaf->count || !equal(leaf->keys[pos], key)) return false;
+
+                for (std::size_t i = pos; i + 1 < leaf->count; ++i) {
+                    leaf->keys[i] = std::move(leaf->keys[i + 1]);
+                    leaf->values[i] = std::move(leaf->values[i + 1]);
+                }
+                --leaf->count;
+                return true;
+            }
+
+            auto *inner = static_cast<Inner *>(node);
+            const std::size_t index = upper(inner, key);
+            if (!erase_recursive(inner->children[index], key)) return false;
+
+            if (inner->children[index]->count < min_keys) {
+                rebalance(inner, index);
+            }
+            return true;
+        }
+
+    public:
+        /**
+         * @brief A forward iterator over the key/value pairs in key order.
+         */
+        class Iterator {
+            Leaf *leaf;
+            std::size_t index;
+
+            void normalize() {
+                while (leaf != nullptr && index >= leaf->count) {
+                    leaf = leaf->next;
+                    index = 0;
+                }
+            }
+
+            friend class BPlusTree;
+
+        public:
+            Iterator(Leaf *leaf, const std::size_t index) : leaf(leaf), index(index) {
+                normalize();
+            }
+
+            /**
+             * @brief Returns the key at the current position.
+             */
+            const K &key() const {
+                return leaf->keys[index];
+            }
+
+            /**
+             * @brief Returns the value at the current position.
+             */
+            V &value() const {
+                return leaf->values[index];
+            }
+
+            std::pair<const K &, V &> operator*() const {
+                return {leaf->keys[index], leaf->values[index]};
+            }
+
+            Iterator &operator++() {
+                ++index;
+                normalize();
+                return *this;
+            }
+
+            bool operator==(const Iterator &other) const {
+                return leaf == other.leaf && index == other.index;
+            }
+
+            bool operator!=(const Iterator &other) const {
+                return !(*this == other);
+            }
+        };
+
+        /**
+         * @brief A half-open range of iterators, usable in a range-based for loop.
+         */
+        class Range {
+            Iterator first;
+            Iterator last;
+
+        public:
+            Range(const Iterator first, const Iterator last) : first(first), last(last) {}
+
+            Iterator begin() const {
+                return first;
+            }
+
+            Iterator end() const {
+                return last;
+            }
+        };
+
+        /**
+         * @brief Constructs an empty tree.
+         */
+        explicit BPlusTree() : root(nullptr), first(nullptr), size(0) {}
+
+        BPlusTree(const BPlusTree &) = delete;
+
+        BPlusTree &operator=(const BPlusTree &) = delete;
+
+        /**
+         * @brief Destructor that frees every node.
+         */
+        ~BPlusTree() {
+            clear();
+        }
+
+        /**
+         * @brief Checks if the tree is empty.
+         * @return true if the tree holds no keys, false otherwise.
+         */
+        bool empty() const noexcept {
+            return size == 0;
+        }
+
+        /**
+         * @brief Retrieves the number of keys in the tree.
+         * @return The number of keys.
+         */
+        std::size_t get_size() const noexcept {
+            return size;
+        }
+
+        /**
+         * @brief Inserts a key/value pair if the key is not present yet.
+         * @param key The key to insert.
+         * @param value The value to associate with the key.
+         * @return true if the pair was inserted, false if the key already existed (its value is left unchanged).
+         */
+        bool insert(const K &key, const V &value) {
+            return insert_impl(key, value, false);
+        }
+
+        /**
+         * @brief Inserts a key/value pair, or replaces the value if the key is already present.
+         * @param key The key to insert.
+         * @param value The value to associate with the key.
+         * @return true if the key was inserted, false if an existing value was replaced.
+         */
+        bool insert_or_assign(const K &key, const V &value) {
+            return insert_impl(key, value, true);
+        }
+
+        /**
+         * @brief Removes a key and its value.
+         * @param key The key to remove.
+         * @return true if the key was found and removed, false otherwise.
+         */
+        bool erase(const K &key) {
+            if (root == nullptr || !erase_recursive(root, key)) return false;
+
+            if (!root->leaf && root->count == 0) {
+                auto *old_root = static_cast<Inner *>(root);
+                root = old_root->children[0];
+                delete old_root;
+            }
+
+            --size;
+            return true;
+        }
+
+        /**
+         * @brief Finds the value stored for a key.
+         * @param key The key to search for.
+         * @return A pointer to the value if found, nullptr otherwise.
+         */
+        V *find(const K &key) const {
+            if (root == nullptr) return nullptr;
+
+            Leaf *leaf = find_leaf(key);
+            const std::size_t pos = lower(leaf, key);
+            if (pos < leaf->count && equal(leaf->keys[pos], key)) return &leaf->values[pos];
+            return nullptr;
+        }
+
+        /**
+         * @brief Checks whether a key is in the tree.
+         * @param key The key to search for.
+         * @return true if the key is present, false otherwise.
+         */
+        bool contains(const K &key) const {
+            return find(key) != nullptr;
+        }
+
+        /**
+         * @brief Returns an iterator to the smallest key.
+         */
+        Iterator begin() const {
+            return Iterator(first, 0);
+        }
+
+        /**
+         * @brief Returns the past-the-end iterator.
+         */
+        Iterator end() const {
+            return Iterator(nullptr, 0);
+        }
+
+        /**
+         * @brief Returns an iterator to the first key that is not less than the given key.
+         * @param key The key to compare against.
+         * @return The iterator, or end() if every key is less than the given key.
+         */
+        Iterator lower_bound(const K &key) const {
+            if (root == nullptr) return end();
+            Leaf *leaf = find_leaf(key);
+            return Iterator(leaf, lower(leaf, key));
+        }
+
+        /**
+         * @brief Returns an iterator to the first key that is greater than the given key.
+         * @param key The key to compare against.
+         * @return The iterator, or end() if no key is greater than the given key.
+         */
+        Iterator upper_bound(const K &key) const {
+            if (root == nullptr) return end();
+            Leaf *leaf = find_leaf(key);
+            return Iterator(leaf, upper(leaf, key));
+        }
+
+        /**
+         * @brief Returns the keys in the half-open interval [from, to).
+         *
+         * @code
+         * for (auto [key, value] : tree.range(10, 20)) { ... }
+         * @endcode
+         *
+         * @param from The inclusive lower bound.
+         * @param to The exclusive upper bound.
+         * @return The range of matching pairs, empty if to is not greater than from.
+         */
+        Range range(const K &from, const K &to) const {
+            if (!(from < to)) return Range(end(), end());
+            return Range(lower_bound(from), lower_bound(to));
+        }
+
+        /**
+         * @brief Replaces the contents of the tree with pairs read from a sorted sequence.
+         *
+         * Leaves are filled to capacity and the inner levels are built bottom-up, which is
+         * O(n) and produces a tree that is faster to scan than one built by repeated insertion.
+         *
+         * @param begin Iterator to the first pair; pairs expose .first (key) and .second (value).
+         * @param end Iterator past the last pair.
+         * @throws std::runtime_error If the keys are not strictly increasing.
+         */
+        template<typename It>
+        void bulk_load(It begin, It end) {
+            std::vector<std::pair<K, V> > pairs;
+            for (; begin != end; ++begin) {
+                if (!pairs.empty() && !(pairs.back().first < (*begin).first)) {
+                    throw std::runtime_error("Bulk load input must be sorted by strictly increasing keys");
+                }
+                pairs.emplace_back((*begin).first, (*begin).second);
+            }
+
+            clear();
+            if (pairs.empty()) return;
+
+            // Spread the pairs evenly so that no leaf ends up below the minimum occupancy.
+            std::vector<std::pair<K, Node *> > level;
+            const std::size_t leaf_count = (pairs.size() + capacity - 1) / capacity;
+            Leaf *prev = nullptr;
+
+            for (std::size_t l = 0, offset = 0; l < leaf_count; ++l) {
+                const std::size_t take = pairs.size() / leaf_count + (l < pairs.size() % leaf_count ? 1 : 0);
+                auto *leaf = new Leaf();
+
+                for (std::size_t i = 0; i < take; ++i) {
+                    leaf->keys[i] = std::move(pairs[offset + i].first);
+                    leaf->values[i] = std::move(pairs[offset + i].second);
+                }
+                leaf->count = static_cast<std::uint16_t>(take);
+                offset += take;
+
+                leaf->prev = prev;
+                if (prev != nullptr) prev->next = leaf;
+                else first = leaf;
+                prev = leaf;
+
+                level.emplace_back(leaf->keys[0], leaf);
+            }
+
+            while (level.size() > 1) {
+                std::vector<std::pair<K, Node *> > parents;
+                const std::size_t node_count = (level.size() + capacity) / (capacity + 1);
+
+                for (std::size_t n = 0, offset = 0; n < node_count; ++n) {
+                    const std::size_t take = level.size() / node_count + (n < level.size() % node_count ? 1 : 0);
+                    auto *inner = new Inner();
+
+                    inner->children[0] = level[offset].second;
+                    for (std::size_t i = 1; i < take; ++i) {
+                        inner->keys[i - 1] = level[offset + i].first;
+                        inner->children[i] = level[offset + i].second;
+                    }
+                    inner->count = static_cast<std::uint16_t>(take - 1);
+
+                    parents.emplace_back(level[offset].first, inner);
+                    offset += take;
+                }
+
+                level = std::move(parents);
+            }
+
+            root = level[0].second;
+            size = pairs.size();
+        }
+
+        /**
+         * @brief Removes every key and frees all nodes.
+         */
+        void clear() {
+            destroy(root);
+            root = nullptr;
+            first = nullptr;
+            size = 0;
+        }
+
+        /**
+         * @brief Displays the contents of the tree in key order.
+         * @remark Only works when both K and V can be written to std::ostream.
+         */
+        void show() const {
+            std::cout << "{";
+
+            for (auto iter = begin(); iter != end();) {
+                std::cout << iter.key() << ": " << iter.value();
+                if (++iter != end()) {
+                    std::cout << ", ";
+                }
+            }
+
+            std::cout << "}\n";
+        }
+    };
+} // DS
+
+#endif //BPLUSTREE_H
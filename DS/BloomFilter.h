@@ -0,0 +1,298 @@
+#ifndef BLOOMFILTER_H
+#define BLOOMFILTER_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "Hash.h"
+
+namespace DS {
+    /**
+     * @brief A register-blocked (split block) Bloom filter.
+     *
+     * Every key maps to a single 256-bit block, i.e. half a cache line and one AVX2
+     * register. Inside the block the key sets one bit in each of the eight 32-bit lanes,
+     * so an insert is one OR and a lookup is one test of the block against an eight-bit
+     * mask. Compared to a classic Bloom filter this costs a slightly higher false positive
+     * rate for the same memory, which the sizing constructor compensates for.
+     *
+     * A lookup that returns false is definite: the key was never inserted. A lookup that
+     * returns true may be a false positive.
+     */
+    class BloomFilter {
+        struct alignas(32) Block {
+            std::uint32_t words[8];
+        };
+
+        static constexpr std::uint32_t salt[8] = {
+            0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+            0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U
+        };
+        static constexpr char magic[4] = {'D', 'S', 'B', 'F'};
+        static constexpr std::uint32_t format_version = 1;
+
+        Block *blocks;
+        std::size_t block_count;
+
+        std::size_t block_index(const std::uint64_t hash) const {
+            // Multiply-shift range reduction: maps the high 32 bits uniformly onto [0, block_count).
+            return static_cast<std::size_t>(((hash >> 32) * block_count) >> 32);
+        }
+
+        /**
+         * @brief Estimates the false positive rate of a filter with the given number of blocks.
+         *
+         * The number of keys per block is Poisson distributed; a block holding j keys
+         * answers a random probe positively with probability (1 - (31/32)^j)^8.
+         */
+        static double estimate_false_positive_rate(const double items, const double blocks) {
+            const double load = items / blocks;
+            const std::size_t limit = static_cast<std::size_t>(load + 20.0 * std::sqrt(load) + 20.0);
+            double rate = 0.0;
+
+            for (std::size_t j = 0; j <= limit; ++j) {
+                const double jd = static_cast<double>(j);
+                const double poisson = std::exp(-load + jd * std::log(load) - std::lgamma(jd + 1.0));
+                rate += poisson * std::pow(1.0 - std::pow(31.0 / 32.0, jd), 8.0);
+            }
+
+            return rate;
+        }
+
+        static void write_u32(std::vector<std::uint8_t> &out, const std::uint32_t value) {
+            for (std::size_t i = 0; i < 4; ++i) out.push_back(static_cast<std::uint8_t>(value >> (i * 8)));
+        }
+
+        static std::uint32_t read_u32(const std::uint8_t *in) {
+            std::uint32_t value = 0;
+            for (std::size_t i = 0; i < 4; ++i) value |= static_cast<std::uint32_t>(in[i]) << (i * 8);
+            return value;
+        }
+
+        static void write_u64(std::vector<std::uint8_t> &out, const std::uint64_t value) {
+            for (std::size_t i = 0; i < 8; ++i) out.push_back(static_cast<std::uint8_t>(value >> (i * 8)));
+        }
+
+        static std::uint64_t read_u64(const std::uint8_t *in) {
+            std::uint64_t value = 0;
+            for (std::size_t i = 0; i < 8; ++i) value |= static_cast<std::uint64_t>(in[i]) << (i * 8);
+            return value;
+        }
+
+        explicit BloomFilter(const std::size_t block_count, std::nullptr_t)
+            : blocks(new Block[block_count]()), block_count(block_count) {}
+
+    public:
+        /**
+         * @brief Constructs an empty filter sized for a number of keys and a target false positive rate.
+         *
+         * @param expected_items The number of keys the filter should hold.
+         * @param false_positive_rate The target probability that a key that was never inserted is reported present.
+         * @throws std::runtime_error If the rate is not strictly between 0 and 1.
+         */
+        explicit BloomFilter(std::size_t expected_items, const double false_positive_rate = 0.01) {
+            if (!(false_positive_rate > 0.0 && false_positive_rate < 1.0)) {
+                throw std::runtime_error("Invalid false positive rate");
+            }
+            if (expected_items == 0) expected_items = 1;
+
+            // Start from the classic Bloom filter size, then grow until the blocked estimate meets the target.
+            const double items = static_cast<double>(expected_items);
+            const double bits = -items * std::log(false_positive_rate) / (std::log(2.0) * std::log(2.0));
+            double count = std::ceil(bits / 256.0);
+            if (count < 1.0) count = 1.0;
+
+            while (estimate_false_positive_rate(items, count) > false_positive_rate) {
+                count = std::ceil(count * 1.05) + 1.0;
+            }
+
+            block_count = static_cast<std::size_t>(count);
+            blocks = new Block[block_count]();
+        }
+
+        BloomFilter(const BloomFilter &other) : blocks(new Block[other.block_count]), block_count(other.block_count) {
+            std::memcpy(blocks, other.blocks, block_count * sizeof(Block));
+        }
+
+        BloomFilter(BloomFilter &&other) noexcept : blocks(other.blocks), block_count(other.block_count) {
+            other.blocks = nullptr;
+            other.block_count = 0;
+        }
+
+        BloomFilter &operator=(BloomFilter other) noexcept {
+            std::swap(blocks, other.blocks);
+            std::swap(block_count, other.block_count);
+            return *this;
+        }
+
+        /**
+         * @brief Destructor that frees the blocks.
+         */
+        ~BloomFilter() {
+            delete[] blocks;
+        }
+
+        /**
+         * @brief Adds a precomputed 64-bit hash to the filter.
+         * @param hash A well-mixed hash of the key.
+         */
+        void insert_hash(const std::uint64_t hash) {
+            Block &block = blocks[block_index(hash)];
+            const auto low = static_cast<std::uint32_t>(hash);
+#if defined(__AVX2__)
+            const __m256i lanes = _mm256_srli_epi32(
+                _mm256_mullo_epi32(_mm256_set1_epi32(static_cast<int>(low)),
+                                   _mm256_loadu_si256(reinterpret_cast<const __m256i *>(salt))), 27);
+            const __m256i mask = _mm256_sllv_epi32(_mm256_set1_epi32(1), lanes);
+            auto *target = reinterpret_cast<__m256i *>(block.words);
+            _mm256_store_si256(target, _mm256_or_si256(_mm256_load_si256(target), mask));
+#else
+            for (std::size_t i = 0; i < 8; ++i) {
+                block.words[i] |= 1u << ((low * salt[i]) >> 27);
+            }
+#endif
+        }
+
+        /**
+         * @brief Tests a precomputed 64-bit hash against the filter.
+         * @param hash A well-mixed hash of the key.
+         * @return false if the key was definitely never inserted, true if it may have been.
+         */
+        bool may_contain_hash(const std::uint64_t hash) const {
+            const Block &block = blocks[block_index(hash)];
+            const auto low = static_cast<std::uint32_t>(hash);
+#if defined(__AVX2__)
+            const __m256i lanes = _mm256_srli_epi32(
+                _mm256_mullo_epi32(_mm256_set1_epi32(static_cast<int>(low)),
+                                   _mm256_loadu_si256(reinterpret_cast<const __m256i *>(salt))), 27);
+            const __m256i mask = _mm256_sllv_epi32(_mm256_set1_epi32(1), lanes);
+            return _mm256_testc_si256(_mm256_load_si256(reinterpret_cast<const __m256i *>(block.words)), mask);
+#else
+            for (std::size_t i = 0; i < 8; ++i) {
+                if (!(block.words[i] & (1u << ((low * salt[i]) >> 27)))) return false;
+            }
+            return true;
+#endif
+        }
+
+        /**
+         * @brief Adds a key to the filter.
+         * @param key The key to add; hashed with DS::Hash.
+         */
+        template<typename T>
+        void insert(const T &key) {
+            insert_hash(static_cast<std::uint64_t>(DS::Hash<T>{}(key)));
+        }
+
+        /**
+         * @brief Tests whether a key may have been added.
+         * @param key The key to test; hashed with DS::Hash.
+         * @return false if the key was definitely never inserted, true if it may have been.
+         */
+        template<typename T>
+        bool may_contain(const T &key) const {
+            return may_contain_hash(static_cast<std::uint64_t>(DS::Hash<T>{}(key)));
+        }
+
+        /**
+         * @brief Adds every key of another filter to this one (bitwise OR).
+         * @param other A filter with the same number of blocks.
+         * @throws std::runtime_error If the filters have different sizes.
+         */
+        void merge(const BloomFilter &other) {
+            if (other.block_count != block_count) {
+                throw std::runtime_error("Cannot merge Bloom filters of different sizes");
+            }
+
+            for (std::size_t i = 0; i < block_count; ++i) {
+                for (std::size_t j = 0; j < 8; ++j) {
+                    blocks[i].words[j] |= other.blocks[i].words[j];
+                }
+            }
+        }
+
+        /**
+         * @brief Removes every key from the filter.
+         */
+        void clear() {
+            std::memset(static_cast<void *>(blocks), 0, block_count * sizeof(Block));
+        }
+
+        /**
+         * @brief Returns the number of 256-bit blocks.
+         */
+        std::size_t get_block_count() const noexcept {
+            return block_count;
+        }
+
+        /**
+         * @brief Returns the memory used by the bit array, in bytes.
+         */
+        std::size_t size_in_bytes() const noexcept {
+            return block_count * sizeof(Block);
+        }
+
+        /**
+         * @brief Serializes the filter to a portable little-endian byte string.
+         *
+         * Layout: "DSBF", u32 format version, u64 block count, then 8 u32 words per block.
+         *
+         * @return The serialized filter.
+         */
+        std::vector<std::uint8_t> serialize() const {
+            std::vector<std::uint8_t> out;
+            out.reserve(16 + size_in_bytes());
+            for (const char c: magic) out.push_back(static_cast<std::uint8_t>(c));
+            write_u32(out, format_version);
+            write_u64(out, block_count);
+
+            for (std::size_t i = 0; i < block_count; ++i) {
+                for (const std::uint32_t word: blocks[i].words) write_u32(out, word);
+            }
+
+            return out;
+        }
+
+        /**
+         * @brief Rebuilds a filter from the output of serialize().
+         * @param bytes The serialized filter.
+         * @return The filter.
+         * @throws std::runtime_error If the bytes are not a valid serialized filter.
+         */
+        static BloomFilter deserialize(const std::vector<std::uint8_t> &bytes) {
+            if (bytes.size() < 16 || std::memcmp(bytes.data(), magic, 4) != 0) {
+                throw std::runtime_error("Invalid Bloom filter data");
+            }
+
+            const std::uint32_t version = read_u32(bytes.data() + 4);
+            if (version != format_version) throw std::runtime_error("Unsupported Bloom filter version");
+
+            const std::uint64_t count = read_u64(bytes.data() + 8);
+            if (count == 0 || (bytes.size() - 16) / sizeof(Block) != count || (bytes.size() - 16) % sizeof(Block)) {
+                throw std::runtime_error("Invalid Bloom filter data");
+            }
+
+            BloomFilter filter(static_cast<std::size_t>(count), nullptr);
+            const std::uint8_t *in = bytes.data() + 16;
+
+            for (std::size_t i = 0; i < filter.block_count; ++i) {
+                for (std::uint32_t &word: filter.blocks[i].words) {
+                    word = read_u32(in);
+                    in += 4;
+                }
+            }
+
+            return filter;
+        }
+    };
+} // DS
+
+#endif //BLOOMFILTER_H
@@ -0,0 +1,375 @@
+#ifndef CSRGRAPH_H
+#define CSRGRAPH_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace DS {
+    /**
+     * @brief A static graph in compressed sparse row (CSR) form.
+     *
+     * The neighbors of every vertex are stored contiguously in one flat target array, and
+     * an offset array of vertex_count() + 1 entries marks where each vertex's neighbors
+     * begin. Each adjacency list is sorted. Directed graphs also keep the transposed CSR
+     * so that in-neighbors are as cheap to scan as out-neighbors.
+     *
+     * The graph is built from edge arrays in parallel: degrees are counted with atomic
+     * increments, turned into offsets with a two-pass parallel prefix sum, and edges are
+     * scattered through per-vertex atomic cursors.
+     *
+     * @tparam Vertex The unsigned integer type of vertex ids.
+     */
+    template<typename Vertex = std::uint32_t>
+    class CSRGraph {
+    public:
+        /**
+         * @brief The neighbors of a vertex, as a contiguous range.
+         */
+        struct Neighbors {
+            const Vertex *first;
+            const Vertex *last;
+
+            const Vertex *begin() const noexcept {
+                return first;
+            }
+
+            const Vertex *end() const noexcept {
+                return last;
+            }
+
+            std::size_t size() const noexcept {
+                return static_cast<std::size_t>(last - first);
+            }
+        };
+
+        /**
+         * @brief The parent of a vertex that breadth_first_search() did not reach.
+         */
+        static constexpr Vertex none = std::numeric_limits<Vertex>::max();
+
+    private:
+        static constexpr std::uint64_t alpha = 15; ///< Go bottom-up once the frontier's edges exceed 1/alpha of the unexplored edges.
+        static constexpr std::uint64_t beta = 18; ///< Go back top-down once the frontier shrinks below 1/beta of the vertices.
+
+        std::size_t n;
+        bool directed;
+        std::vector<std::uint64_t> offsets;
+        std::vector<Vertex> targets;
+        std::vector<std::uint64_t> in_offsets; ///< Transposed CSR; empty for undirected graphs.
+        std::vector<Vertex> in_targets;
+
+        static unsigned resolve(unsigned threads) {
+            if (threads == 0) threads = std::thread::hardware_concurrency();
+            return threads == 0 ? 1 : threads;
+        }
+
+        /**
+         * @brief Runs fn(begin, end, thread) over contiguous chunks of [0, count), one chunk per thread.
+         *
+         * Chunk boundaries are multiples of granularity, so that threads can own whole bitmap words.
+         */
+        template<typename Fn>
+        static void parallel_for(const std::size_t count, const unsigned threads, Fn fn,
+                                 const std::size_t granularity = 1) {
+            if (threads <= 1 || count <= granularity) {
+                fn(std::size_t{0}, count, 0U);
+                return;
+            }
+
+            const std::size_t units = (count + granularity - 1) / granularity;
+            const std::size_t chunk = (units + threads - 1) / threads * granularity;
+            std::vector<std::thread> workers;
+
+            for (unsigned t = 1; t < threads && t * chunk < count; ++t) {
+                const std::size_t begin = t * chunk;
+                const std::size_t end = std::min(count, begin + chunk);
+                workers.emplace_back([&fn, begin, end, t] { fn(begin, end, t); });
+            }
+            fn(std::size_t{0}, std::min(count, chunk), 0U);
+
+            for (std::thread &worker: workers) worker.join();
+        }
+
+        /**
+         * @brief Builds one CSR from edge arrays; with both_directions every edge is stored from both ends.
+         */
+        static void build(const std::size_t n, const Vertex *from, const Vertex *to, const std::size_t edges,
+                          const bool both_directions, const unsigned threads, std::vector<std::uint64_t> &offsets,
+                          std::vector<Vertex> &targets) {
+            std::unique_ptr<std::atomic<std::uint64_t>[]> cursor(new std::atomic<std::uint64_t>[n]);
+            parallel_for(n, threads, [&](const std::size_t begin, const std::size_t end, unsigned) {
+                for (std::size_t v = begin; v < end; ++v) cursor[v].store(0, std::memory_order_relaxed);
+            });
+
+            parallel_for(edges, threads, [&](const std::size_t begin, const std::size_t end, unsigned) {
+                for (std::size_t e = begin; e < end; ++e) {
+                    cursor[from[e]].fetch_add(1, std::memory_order_relaxed);
+                    if (both_directions) cursor[to[e]].fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+
+            // Two-pass prefix sum: every thread sums its chunk, then offsets its chunk by the sums before it.
+            offsets.assign(n + 1, 0);
+            std::vector<std::uint64_t> chunk_sums(threads + 1, 0);
+            parallel_for(n, threads, [&](const std::size_t begin, const std::size_t end, const unsigned t) {
+                std::uint64_t sum = 0;
+                for (std::size_t v = begin; v < end; ++v) sum += cursor[v].load(std::memory_order_relaxed);
+                chunk_sums[t + 1] = sum;
+            });
+            for (unsigned t = 0; t < threads; ++t) chunk_sums[t + 1] += chunk_sums[t];
+
+            parallel_for(n, threads, [&](const std::size_t begin, const std::size_t end, const unsigned t) {
+                std::uint64_t sum = chunk_sums[t];
+                for (std::size_t v = begin; v < end; ++v) {
+                    const std::uint64_t degree = cursor[v].load(std::memory_order_relaxed);
+                    offsets[v] = sum;
+                    cursor[v].store(sum, std::memory_order_relaxed);
+                    sum += degree;
+                }
+            });
+            offsets[n] = chunk_sums[threads];
+
+            targets.resize(static_cast<std::size_t>(offsets[n]));
+            parallel_for(edges, threads, [&](const std::size_t begin, const std::size_t end, unsigned) {
+                for (std::size_t e = begin; e < end; ++e) {
+                    targets[cursor[from[e]].fetch_add(1, std::memory_order_relaxed)] = to[e];
+                    if (both_directions) targets[cursor[to[e]].fetch_add(1, std::memory_order_relaxed)] = from[e];
+                }
+            });
+
+            parallel_for(n, threads, [&](const std::size_t begin, const std::size_t end, unsigned) {
+                for (std::size_t v = begin; v < end; ++v) {
+                    std::sort(targets.begin() + static_cast<std::ptrdiff_t>(offsets[v]),
+                              targets.begin() + static_cast<std::ptrdiff_t>(offsets[v + 1]));
+                }
+            });
+        }
+
+        using Bitmap = std::unique_ptr<std::atomic<std::uint64_t>[]>;
+
+        static bool test(const Bitmap &bitmap, const std::size_t v) {
+            return (bitmap[v / 64].load(std::memory_order_relaxed) >> (v % 64)) & 1;
+        }
+
+        /**
+         * @brief Expands the frontier from a vertex queue; returns the number of edges of the discovered vertices.
+         */
+        std::uint64_t top_down_step(std::vector<Vertex> &frontier, std::atomic<Vertex> *parent,
+                                    std::vector<std::vector<Vertex> > &buffers, const unsigned threads) const {
+            std::vector<std::uint64_t> scouts(threads, 0);
+
+            parallel_for(frontier.size(), threads, [&](const std::size_t begin, const std::size_t end, const unsigned t) {
+                std::vector<Vertex> &next = buffers[t];
+                std::uint64_t scout = 0;
+
+                for (std::size_t i = begin; i < end; ++i) {
+                    const Vertex u = frontier[i];
+                    for (const Vertex v: neighbors(u)) {
+                        Vertex expected = parent[v].load(std::memory_order_relaxed);
+                        if (expected == none &&
+                            parent[v].compare_exchange_strong(expected, u, std::memory_order_relaxed)) {
+                            next.push_back(v);
+                            scout += degree(v);
+                        }
+                    }
+                }
+                scouts[t] = scout;
+            });
+
+            frontier.clear();
+            std::uint64_t scout = 0;
+            for (unsigned t = 0; t < threads; ++t) {
+                frontier.insert(frontier.end(), buffers[t].begin(), buffers[t].end());
+                buffers[t].clear();
+                scout += scouts[t];
+            }
+            return scout;
+        }
+
+        /**
+         * @brief Lets every unvisited vertex look for a parent in the frontier bitmap; returns the number found.
+         */
+        std::size_t bottom_up_step(const Bitmap &frontier, const Bitmap &next, std::atomic<Vertex> *parent,
+                                   const unsigned threads) const {
+            std::vector<std::size_t> awake(threads, 0);
+
+            // Chunks are whole words, so every thread writes only its own words of next.
+            parallel_for(n, threads, [&](const std::size_t begin, const std::size_t end, const unsigned t) {
+                std::size_t found = 0;
+                for (std::size_t word = begin / 64; word < (end + 63) / 64; ++word) {
+                    std::uint64_t bits = 0;
+                    for (std::size_t v = word * 64; v < std::min(end, word * 64 + 64); ++v) {
+                        if (parent[v].load(std::memory_order_relaxed) != none) continue;
+                        for (const Vertex u: in_neighbors(static_cast<Vertex>(v))) {
+                            if (test(frontier, u)) {
+                                parent[v].store(u, std::memory_order_relaxed);
+                                bits |= std::uint64_t{1} << (v % 64);
+                                ++found;
+                                break;
+                            }
+                        }
+                    }
+                    next[word].store(bits, std::memory_order_relaxed);
+                }
+                awake[t] = found;
+            }, 64);
+
+            std::size_t total = 0;
+            for (const std::size_t count: awake) total += count;
+            return total;
+        }
+
+    public:
+        /**
+         * @brief Builds a graph from edge arrays.
+         *
+         * @param vertex_count The number of vertices; vertex ids are [0, vertex_count).
+         * @param from The source of each edge.
+         * @param to The target of each edge.
+         * @param edge_count The number of edges.
+         * @param directed false to store every edge in both directions.
+         * @param threads The number of worker threads; 0 uses std::thread::hardware_concurrency().
+         * @throws std::out_of_range If an endpoint is not a vertex.
+         * @throws std::runtime_error If vertex_count does not fit in Vertex.
+         */
+        CSRGraph(const std::size_t vertex_count, const Vertex *from, const Vertex *to, const std::size_t edge_count,
+                 const bool directed = false, unsigned threads = 0) : n(vertex_count), directed(directed) {
+            if (vertex_count > none) throw std::runtime_error("Too many vertices");
+            threads = resolve(threads);
+
+            std::atomic<bool> valid{true};
+            parallel_for(edge_count, threads, [&](const std::size_t begin, const std::size_t end, unsigned) {
+                for (std::size_t e = begin; e < end; ++e) {
+                    if (from[e] >= n || to[e] >= n) valid.store(false, std::memory_order_relaxed);
+                }
+            });
+            if (!valid.load()) throw std::out_of_range("Edge endpoint out of bounds");
+
+            build(n, from, to, edge_count, !directed, threads, offsets, targets);
+            if (directed) build(n, to, from, edge_count, false, threads, in_offsets, in_targets);
+        }
+
+        /**
+         * @brief Returns the number of vertices.
+         */
+        std::size_t vertex_count() const noexcept {
+            return n;
+        }
+
+        /**
+         * @brief Returns the number of stored edges; an undirected edge counts twice.
+         */
+        std::size_t edge_count() const noexcept {
+            return targets.size();
+        }
+
+        bool is_directed() const noexcept {
+            return directed;
+        }
+
+        /**
+         * @brief Returns the number of out-neighbors of a vertex. The vertex is not bounds checked.
+         */
+        std::size_t degree(const Vertex v) const {
+            return static_cast<std::size_t>(offsets[v + 1] - offsets[v]);
+        }
+
+        /**
+         * @brief Returns the sorted out-neighbors of a vertex. The vertex is not bounds checked.
+         */
+        Neighbors neighbors(const Vertex v) const {
+            return {targets.data() + offsets[v], targets.data() + offsets[v + 1]};
+        }
+
+        /**
+         * @brief Returns the sorted in-neighbors of a vertex. The vertex is not bounds checked.
+         */
+        Neighbors in_neighbors(const Vertex v) const {
+            if (!directed) return neighbors(v);
+            return {in_targets.data() + in_offsets[v], in_targets.data() + in_offsets[v + 1]};
+        }
+
+        /**
+         * @brief Runs a parallel direction-optimizing breadth-first search (Beamer et al.).
+         *
+         * Levels are expanded top-down from a vertex queue while the frontier is small;
+         * each thread collects the vertices it discovers in its own buffer. Once the
+         * frontier's edges outnumber a fraction of the unexplored edges, the search
+         * switches to bottom-up steps over a frontier bitmap, where each unvisited vertex
+         * scans its in-neighbors and stops at the first one in the frontier. It switches
+         * back once the frontier is small again.
+         *
+         * @param source The vertex to start from.
+         * @param threads The number of worker threads; 0 uses std::thread::hardware_concurrency().
+         * @return parent[v] is the BFS-tree parent of v, source for the source, and none if v is unreachable.
+         * @throws std::out_of_range If the source is not a vertex.
+         */
+        std::vector<Vertex> breadth_first_search(const Vertex source, unsigned threads = 0) const {
+            if (source >= n) throw std::out_of_range("Vertex out of bounds");
+            threads = resolve(threads);
+
+            std::unique_ptr<std::atomic<Vertex>[]> parent(new std::atomic<Vertex>[n]);
+            parallel_for(n, threads, [&](const std::size_t begin, const std::size_t end, unsigned) {
+                for (std::size_t v = begin; v < end; ++v) parent[v].store(none, std::memory_order_relaxed);
+            });
+            parent[source].store(source, std::memory_order_relaxed);
+
+            std::vector<Vertex> frontier{source};
+            std::vector<std::vector<Vertex> > buffers(threads);
+            Bitmap current;
+            Bitmap next;
+            const std::size_t words = (n + 63) / 64;
+
+            std::uint64_t edges_to_check = targets.size();
+            std::uint64_t scout = degree(source);
+
+            while (!frontier.empty()) {
+                if (scout > edges_to_check / alpha) {
+                    if (!current) {
+                        current.reset(new std::atomic<std::uint64_t>[words]);
+                        next.reset(new std::atomic<std::uint64_t>[words]);
+                    }
+                    for (std::size_t w = 0; w < words; ++w) current[w].store(0, std::memory_order_relaxed);
+                    for (const Vertex v: frontier) {
+                        current[v / 64].fetch_or(std::uint64_t{1} << (v % 64), std::memory_order_relaxed);
+                    }
+
+                    std::size_t awake = frontier.size();
+                    std::size_t previous;
+                    do {
+                        previous = awake;
+                        awake = bottom_up_step(current, next, parent.get(), threads);
+                        current.swap(next);
+                    } while (awake > 0 && (awake >= previous || awake > n / beta));
+
+                    frontier.clear();
+                    for (std::size_t w = 0; w < words; ++w) {
+                        for (std::uint64_t bits = current[w].load(std::memory_order_relaxed); bits != 0;
+                             bits &= bits - 1) {
+                            frontier.push_back(static_cast<Vertex>(w * 64 + __builtin_ctzll(bits)));
+                        }
+                    }
+                    scout = 1;
+                } else {
+                    edges_to_check -= std::min(edges_to_check, scout);
+                    scout = top_down_step(frontier, parent.get(), buffers, threads);
+                }
+            }
+
+            std::vector<Vertex> result(n);
+            parallel_for(n, threads, [&](const std::size_t begin, const std::size_t end, unsigned) {
+                for (std::size_t v = begin; v < end; ++v) result[v] = parent[v].load(std::memory_order_relaxed);
+            });
+            return result;
+        }
+    };
+} // DS
+
+#endif //CSRGRAPH_H
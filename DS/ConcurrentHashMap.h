@@ -0,0 +1,423 @@
+#ifndef CONCURRENTHASHMAP_H
+#define CONCURRENTHASHMAP_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "Hash.h"
+#include "SeqLock.h"
+
+namespace DS {
+    /**
+     * @brief A hash map that can be shared between threads.
+     *
+     * The keys are spread over a power-of-two number of shards. Each shard sits on its own
+     * cache lines and owns an open-addressing table (linear probing, backward-shift erase)
+     * protected by a reader-writer mutex and a sequence lock. Writers on different shards
+     * never contend.
+     *
+     * When both K and V are trivially copyable, find() and contains() take the optimistic
+     * path: they copy the slots they probe under the shard's SeqLock and retry if a writer
+     * interfered, so they never write to shared memory. Tables replaced by a resize are
+     * kept until the map is destroyed, because an optimistic reader may still be probing
+     * them; their total size is bounded by the size of the live tables. Other key and
+     * value types are read under a shared lock.
+     *
+     * @tparam K The type of the keys. Must be default constructible and equality comparable.
+     * @tparam V The type of the values. Must be default constructible.
+     * @tparam Hasher The hash function used for the keys.
+     */
+    template<typename K, typename V, typename Hasher = DS::Hash<K> >
+    class ConcurrentHashMap {
+        static constexpr bool optimistic = std::is_trivially_copyable_v<K> && std::is_trivially_copyable_v<V>;
+        static constexpr std::size_t cache_line = 64;
+
+        struct Slot {
+            std::size_t hash; ///< Full hash of the key, to skip most key comparisons.
+            K key;
+            V value;
+            bool occupied;
+        };
+
+        struct Table {
+            std::size_t capacity; ///< Number of slots, always a power of two.
+            Slot *slots;
+            Table *retired; ///< Older table replaced by this one, kept alive for optimistic readers.
+
+            explicit Table(const std::size_t capacity) : capacity(capacity), slots(new Slot[capacity]()),
+                                                        retired(nullptr) {}
+
+            ~Table() {
+                delete[] slots;
+            }
+        };
+
+        struct alignas(cache_line) Shard {
+            mutable std::shared_mutex mutex; ///< Excludes writers; shared by readers of non-trivial types.
+            SeqLock version; ///< Bumped around every write, validates optimistic reads.
+            std::atomic<Table *> table{nullptr};
+            std::size_t size = 0;
+        };
+
+        /**
+         * @brief Keeps a shard's sequence odd for its lifetime, so that a write that throws still ends.
+         */
+        class WriteSection {
+            SeqLock &version;
+
+        public:
+            explicit WriteSection(SeqLock &version) : version(version) {
+                version.write_begin();
+            }
+
+            ~WriteSection() {
+                version.write_end();
+            }
+
+            WriteSection(const WriteSection &) = delete;
+
+            WriteSection &operator=(const WriteSection &) = delete;
+        };
+
+        Shard *shards;
+        std::size_t shard_count;
+        std::size_t shard_mask;
+        Hasher hasher;
+
+        static std::size_t round_up_pow2(const std::size_t value) {
+            std::size_t result = 1;
+            while (result < value) result <<= 1;
+            return result;
+        }
+
+        Shard &shard_for(const std::size_t hash) const {
+            // Low bits pick the slot, high bits pick the shard.
+            return shards[(hash >> (sizeof(std::size_t) * 4)) & shard_mask];
+        }
+
+        /**
+         * @brief Returns the slot holding the key, or the empty slot that ends its probe sequence.
+         */
+        static std::size_t probe(const Table *table, const std::size_t hash, const K &key) {
+            const std::size_t mask = table->capacity - 1;
+            std::size_t index = hash & mask;
+
+            while (table->slots[index].occupied) {
+                const Slot &slot = table->slots[index];
+                if (slot.hash == hash && slot.key == key) break;
+                index = (index + 1) & mask;
+            }
+
+            return index;
+        }
+
+        static void grow(Shard &shard) {
+            Table *old_table = shard.table.load(std::memory_order_relaxed);
+            std::unique_ptr<Table> new_table(new Table(old_table->capacity * 2));
+
+            for (std::size_t i = 0; i < old_table->capacity; ++i) {
+                Slot &slot = old_table->slots[i];
+                if (!slot.occupied) continue;
+                Slot &target = new_table->slots[probe(new_table.get(), slot.hash, slot.key)];
+                // Copying keeps the old table whole if a key or value throws halfway through.
+                if constexpr (std::is_nothrow_move_assignable_v<Slot>) {
+                    target = std::move(slot);
+                } else {
+                    target = slot;
+                }
+            }
+
+            if constexpr (optimistic) {
+                new_table->retired = old_table;
+            } else {
+                delete old_table;
+            }
+            shard.table.store(new_table.release(), std::memory_order_release);
+        }
+
+        /**
+         * @brief Grows the shard's table if one more key would push the load factor above 3/4. Caller holds the write lock.
+         *
+         * Runs before the write section: the new table is only published once it is
+         * complete, and the old one is left intact for optimistic readers, so a failed
+         * allocation leaves the shard as it was.
+         */
+        static void reserve_one(Shard &shard) {
+            const Table *table = shard.table.load(std::memory_order_relaxed);
+            if ((shard.size + 1) * 4 > table->capacity * 3) grow(shard);
+        }
+
+        /**
+         * @brief Inserts a default value for the key if it is missing. Caller holds the write lock and called reserve_one().
+         */
+        static Slot &find_or_insert(Shard &shard, const std::size_t hash, const K &key, bool &inserted) {
+            Table *table = shard.table.load(std::memory_order_relaxed);
+            Slot &slot = table->slots[probe(table, hash, key)];
+            inserted = !slot.occupied;
+
+            if (inserted) {
+                slot.hash = hash;
+                slot.key = key;
+                slot.value = V();
+                slot.occupied = true;
+                ++shard.size;
+            }
+
+            return slot;
+        }
+
+        std::optional<V> find_optimistic(const Shard &shard, const std::size_t hash, const K &key) const {
+            for (;;) {
+                const std::uint64_t start = shard.version.read_begin();
+                const Table *table = shard.table.load(std::memory_order_acquire);
+                const std::size_t mask = table->capacity - 1;
+                std::size_t index = hash & mask;
+                std::optional<V> result;
+
+                // Bounded by the capacity: a torn snapshot must not send us round forever.
+                for (std::size_t probes = 0; probes < table->capacity; ++probes) {
+                    Slot copy;
+                    std::memcpy(static_cast<void *>(&copy), &table->slots[index], sizeof(Slot));
+                    if (!copy.occupied) break;
+                    if (copy.hash == hash && copy.key == key) {
+                        result = copy.value;
+                        break;
+                    }
+                    index = (index + 1) & mask;
+                }
+
+                if (!shard.version.read_retry(start)) return result;
+            }
+        }
+
+        std::optional<V> find_locked(const Shard &shard, const std::size_t hash, const K &key) const {
+            std::shared_lock lock(shard.mutex);
+            const Table *table = shard.table.load(std::memory_order_relaxed);
+            const Slot &slot = table->slots[probe(table, hash, key)];
+            if (!slot.occupied) return std::nullopt;
+            return slot.value;
+        }
+
+    public:
+        /**
+         * @brief Constructs an empty map.
+         *
+         * @param shards The number of shards, rounded up to a power of two. More shards means
+         *               less contention between writers.
+         * @param initial_capacity The initial number of slots per shard, rounded up to a power of two.
+         * @throws std::runtime_error If either argument is zero.
+         */
+        explicit ConcurrentHashMap(const std::size_t shards = 64, const std::size_t initial_capacity = 16) {
+            if (shards == 0) throw std::runtime_error("Invalid shard count");
+            if (initial_capacity == 0) throw std::runtime_error("Invalid capacity");
+
+            shard_count = round_up_pow2(shards);
+            shard_mask = shard_count - 1;
+            this->shards = new Shard[shard_count];
+
+            const std::size_t capacity = round_up_pow2(initial_capacity < 2 ? 2 : initial_capacity);
+            for (std::size_t i = 0; i < shard_count; ++i) {
+                this->shards[i].table.store(new Table(capacity), std::memory_order_relaxed);
+            }
+        }
+
+        ConcurrentHashMap(const ConcurrentHashMap &) = delete;
+
+        ConcurrentHashMap &operator=(const ConcurrentHashMap &) = delete;
+
+        /**
+         * @brief Destroys the map, including the tables retired by resizes.
+         *
+         * No other thread may use the map at this point.
+         */
+        ~ConcurrentHashMap() {
+            for (std::size_t i = 0; i < shard_count; ++i) {
+                Table *table = shards[i].table.load(std::memory_order_relaxed);
+                while (table != nullptr) {
+                    Table *retired = table->retired;
+                    delete table;
+                    table = retired;
+                }
+            }
+            delete[] shards;
+        }
+
+        /**
+         * @brief Looks up the value stored for a key.
+         *
+         * Lock-free when K and V are trivially copyable.
+         *
+         * @param key The key to look up.
+         * @return A copy of the value, or std::nullopt if the key is not in the map.
+         */
+        std::optional<V> find(const K &key) const {
+            const std::size_t hash = hasher(key);
+            const Shard &shard = shard_for(hash);
+
+            if constexpr (optimistic) {
+                return find_optimistic(shard, hash, key);
+            } else {
+                return find_locked(shard, hash, key);
+            }
+        }
+
+        /**
+         * @brief Checks whether a key is in the map.
+         *
+         * @param key The key to look for.
+         * @return true if the key is present, false otherwise.
+         */
+        bool contains(const K &key) const {
+            return find(key).has_value();
+        }
+
+        /**
+         * @brief Inserts a key, or overwrites its value if it is already present.
+         *
+         * @param key The key to insert.
+         * @param value The value to store.
+         * @return true if the key was inserted, false if an existing value was replaced.
+         */
+        bool insert_or_assign(const K &key, const V &value) {
+            const std::size_t hash = hasher(key);
+            Shard &shard = shard_for(hash);
+
+            std::unique_lock lock(shard.mutex);
+            reserve_one(shard);
+            WriteSection write(shard.version);
+            bool inserted;
+            find_or_insert(shard, hash, key, inserted).value = value;
+            return inserted;
+        }
+
+        /**
+         * @brief Applies a function to the value stored for a key, atomically with respect to other writers.
+         *
+         * @param key The key whose value to update.
+         * @param fn A callable invoked as fn(V &) while the key's shard is locked.
+         * @return true if the key was found and updated, false otherwise.
+         */
+        template<typename F>
+        bool update(const K &key, F &&fn) {
+            const std::size_t hash = hasher(key);
+            Shard &shard = shard_for(hash);
+
+            std::unique_lock lock(shard.mutex);
+            Table *table = shard.table.load(std::memory_order_relaxed);
+            Slot &slot = table->slots[probe(table, hash, key)];
+            if (!slot.occupied) return false;
+
+            WriteSection write(shard.version);
+            fn(slot.value);
+            return true;
+        }
+
+        /**
+         * @brief Applies a function to the value stored for a key, inserting a default value first if needed.
+         *
+         * @param key The key whose value to update.
+         * @param fn A callable invoked as fn(V &) while the key's shard is locked. If it
+         *           throws, the key stays in the map with whatever value fn left.
+         * @return true if the key was inserted, false if it was already present.
+         */
+        template<typename F>
+        bool upsert(const K &key, F &&fn) {
+            const std::size_t hash = hasher(key);
+            Shard &shard = shard_for(hash);
+
+            std::unique_lock lock(shard.mutex);
+            reserve_one(shard);
+            WriteSection write(shard.version);
+            bool inserted;
+            fn(find_or_insert(shard, hash, key, inserted).value);
+            return inserted;
+        }
+
+        /**
+         * @brief Removes a key from the map.
+         *
+         * @param key The key to remove.
+         * @return true if the key was found and removed, false otherwise.
+         */
+        bool erase(const K &key) {
+            const std::size_t hash = hasher(key);
+            Shard &shard = shard_for(hash);
+
+            std::unique_lock lock(shard.mutex);
+            Table *table = shard.table.load(std::memory_order_relaxed);
+            const std::size_t mask = table->capacity - 1;
+            std::size_t hole = probe(table, hash, key);
+            if (!table->slots[hole].occupied) return false;
+
+            WriteSection write(shard.version);
+            table->slots[hole].occupied = false;
+
+            // Backward-shift deletion: pull later entries of the same cluster into the hole
+            // so that no tombstones are needed.
+            for (std::size_t next = (hole + 1) & mask; table->slots[next].occupied; next = (next + 1) & mask) {
+                const std::size_t home = table->slots[next].hash & mask;
+                const bool movable = hole <= next ? (home <= hole || home > next) : (home <= hole && home > next);
+                if (movable) {
+                    table->slots[hole] = std::move(table->slots[next]);
+                    table->slots[next].occupied = false;
+                    hole = next;
+                }
+            }
+
+            --shard.size;
+            return true;
+        }
+
+        /**
+         * @brief Returns the number of keys in the map.
+         *
+         * The shards are counted one after the other, so the result is only exact when no
+         * writer runs concurrently.
+         *
+         * @return The number of keys.
+         */
+        std::size_t size() const {
+            std::size_t total = 0;
+            for (std::size_t i = 0; i < shard_count; ++i) {
+                std::shared_lock lock(shards[i].mutex);
+                total += shards[i].size;
+            }
+            return total;
+        }
+
+        /**
+         * @brief Checks if the map is empty.
+         *
+         * @return true if the map holds no keys, false otherwise.
+         */
+        bool empty() const {
+            return size() == 0;
+        }
+
+        /**
+         * @brief Removes all keys. The table capacities are kept.
+         */
+        void clear() {
+            for (std::size_t i = 0; i < shard_count; ++i) {
+                Shard &shard = shards[i];
+                std::unique_lock lock(shard.mutex);
+                WriteSection write(shard.version);
+                Table *table = shard.table.load(std::memory_order_relaxed);
+                for (std::size_t j = 0; j < table->capacity; ++j) {
+                    table->slots[j] = Slot();
+                }
+                shard.size = 0;
+            }
+        }
+    };
+} // DS
+
+#endif //CONCURRENTHASHMAP_H
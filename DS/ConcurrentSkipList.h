@@ -0,0 +1,364 @@
+#ifndef CONCURRENTSKIPLIST_H
+#define CONCURRENTSKIPLIST_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <optional>
+#include <utility>
+
+#include "EpochReclamation.h"
+
+namespace DS {
+    /**
+     * @brief A lock-free ordered map based on a skip list (Fraser / Herlihy-Shavit).
+     *
+     * Every level is a singly linked list updated with compare-and-swap. A node is erased
+     * in two steps: it is logically deleted by setting a mark bit in each of its next
+     * pointers, top level first, and the thread that marks level 0 owns the erasure;
+     * then traversals physically unlink the marked node wherever they pass it. Unlinked
+     * nodes are freed through EpochReclamation, so readers never touch freed memory.
+     * Node heights are geometric with p = 1/2.
+     *
+     * All operations are linearizable except iteration, which is weakly consistent: it
+     * visits keys in order, sees every key present for the whole iteration and never
+     * sees a key twice, but may or may not see keys inserted or erased meanwhile.
+     *
+     * Values are immutable once inserted; erase and re-insert a key to change its value.
+     *
+     * @tparam K The type of the keys. Must be copyable and ordered by Compare.
+     * @tparam V The type of the values. Must be copyable.
+     * @tparam Compare The strict weak ordering of the keys.
+     */
+    template<typename K, typename V, typename Compare = std::less<K> >
+    class ConcurrentSkipList {
+        static constexpr int max_level = 32;
+
+        struct Node {
+            const K key;
+            const V value;
+            const int height;
+            std::atomic<int> owners{2}; ///< The inserter and the eraser; the last one to finish retires the node.
+
+            Node(const K &key, const V &value, const int height) : key(key), value(value), height(height) {}
+
+            static constexpr std::size_t links_offset() {
+                return (sizeof(Node) + alignof(std::atomic<Node *>) - 1) / alignof(std::atomic<Node *>) *
+                       alignof(std::atomic<Node *>);
+            }
+
+            /**
+             * @brief Returns the next pointers of the node, stored right after it.
+             */
+            std::atomic<Node *> *links() const {
+                auto *self = reinterpret_cast<char *>(const_cast<Node *>(this));
+                return reinterpret_cast<std::atomic<Node *> *>(self + links_offset());
+            }
+
+            static Node *create(const K &key, const V &value, const int height) {
+                void *memory = ::operator new(links_offset() + height * sizeof(std::atomic<Node *>));
+                Node *node = new(memory) Node(key, value, height);
+                for (int level = 0; level < height; ++level) new(node->links() + level) std::atomic<Node *>(nullptr);
+                return node;
+            }
+
+            static void destroy(void *pointer) {
+                auto *node = static_cast<Node *>(pointer);
+                node->~Node();
+                ::operator delete(node);
+            }
+        };
+
+        static bool is_marked(const Node *pointer) {
+            return reinterpret_cast<std::uintptr_t>(pointer) & 1;
+        }
+
+        static Node *marked(const Node *pointer) {
+            return reinterpret_cast<Node *>(reinterpret_cast<std::uintptr_t>(pointer) | 1);
+        }
+
+        static Node *unmarked(const Node *pointer) {
+            return reinterpret_cast<Node *>(reinterpret_cast<std::uintptr_t>(pointer) & ~std::uintptr_t{1});
+        }
+
+        std::atomic<Node *> head[max_level];
+        std::atomic<int> top{1}; ///< Highest level that may be non-empty, plus one. Only grows.
+        std::atomic<std::size_t> count{0};
+        Compare less;
+
+        static int random_height() {
+            thread_local std::uint64_t state =
+                    0x9e3779b97f4a7c15ULL ^ reinterpret_cast<std::uintptr_t>(&state);
+            // xorshift64; the number of trailing zeros of a random word is geometric with p = 1/2.
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return 1 + __builtin_ctzll(state | (std::uint64_t{1} << (max_level - 1)));
+        }
+
+        bool before(const Node *node, const K &key) const {
+            return node != nullptr && less(node->key, key);
+        }
+
+        bool matches(const Node *node, const K &key) const {
+            return node != nullptr && !less(key, node->key);
+        }
+
+        /**
+         * @brief Finds the predecessors and successors of a key on every level, unlinking marked nodes on the way.
+         *
+         * preds[l] is the link on level l that points to succs[l], the first node with a
+         * key not less than the key.
+         *
+         * @return true if succs[0] holds the key.
+         */
+        bool locate(const K &key, std::atomic<Node *> **preds, Node **succs) {
+        retry:
+            std::atomic<Node *> *links = head;
+            for (int level = max_level - 1; level >= 0; --level) {
+                Node *current = unmarked(links[level].load(std::memory_order_acquire));
+
+                for (;;) {
+                    if (current == nullptr) break;
+
+                    Node *next = current->links()[level].load(std::memory_order_acquire);
+                    while (is_marked(next)) {
+                        // current is logically deleted: unlink it from this level.
+                        Node *expected = current;
+                        if (!links[level].compare_exchange_strong(expected, unmarked(next), std::memory_order_acq_rel)) {
+                            goto retry;
+                        }
+                        current = unmarked(next);
+                        if (current == nullptr) break;
+                        next = current->links()[level].load(std::memory_order_acquire);
+                    }
+
+                    if (!before(current, key)) break;
+                    links = current->links();
+                    current = unmarked(next);
+                }
+
+                preds[level] = &links[level];
+                succs[level] = current;
+            }
+            return matches(succs[0], key);
+        }
+
+        /**
+         * @brief Finds the first unmarked node with a key not less than the key, without unlinking anything.
+         */
+        Node *seek(const K &key) const {
+            const std::atomic<Node *> *links = head;
+            Node *current = nullptr;
+
+            for (int level = top.load(std::memory_order_acquire) - 1; level >= 0; --level) {
+                current = unmarked(links[level].load(std::memory_order_acquire));
+                while (current != nullptr) {
+                    Node *next = current->links()[level].load(std::memory_order_acquire);
+                    if (is_marked(next)) {
+                        // Step over a logically deleted node; its links stay readable until it is freed.
+                        current = unmarked(next);
+                        continue;
+                    }
+                    if (!before(current, key)) break;
+                    links = current->links();
+                    current = unmarked(next);
+                }
+            }
+            return current;
+        }
+
+        /**
+         * @brief Drops one claim on a node; the last claim unlinks it everywhere and retires it.
+         */
+        void release(Node *node) {
+            if (node->owners.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+
+            std::atomic<Node *> *preds[max_level];
+            Node *succs[max_level];
+            locate(node->key, preds, succs);
+            EpochReclamation::retire(node, &Node::destroy);
+        }
+
+    public:
+        explicit ConcurrentSkipList(const Compare &compare = Compare()) : less(compare) {
+            for (std::atomic<Node *> &link: head) link.store(nullptr, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Frees every node. Must not run concurrently with any other operation.
+         */
+        ~ConcurrentSkipList() {
+            Node *node = unmarked(head[0].load(std::memory_order_relaxed));
+            while (node != nullptr) {
+                Node *next = unmarked(node->links()[0].load(std::memory_order_relaxed));
+                Node::destroy(node);
+                node = next;
+            }
+        }
+
+        ConcurrentSkipList(const ConcurrentSkipList &) = delete;
+
+        ConcurrentSkipList &operator=(const ConcurrentSkipList &) = delete;
+
+        /**
+         * @brief Inserts a key with a value.
+         * @return true if the key was inserted, false if it was already present.
+         */
+        bool insert(const K &key, const V &value) {
+            EpochReclamation::Guard guard;
+            std::atomic<Node *> *preds[max_level];
+            Node *succs[max_level];
+
+            const int height = random_height();
+            Node *node = nullptr;
+
+            for (;;) {
+                if (locate(key, preds, succs)) {
+                    if (node != nullptr) Node::destroy(node);
+                    return false;
+                }
+
+                if (node == nullptr) node = Node::create(key, value, height);
+                for (int level = 0; level < height; ++level) {
+                    node->links()[level].store(succs[level], std::memory_order_relaxed);
+                }
+
+                // Linking level 0 publishes the node: the key is now present.
+                Node *expected = succs[0];
+                if (preds[0]->compare_exchange_strong(expected, node, std::memory_order_acq_rel)) break;
+            }
+
+            count.fetch_add(1, std::memory_order_relaxed);
+            for (int current_top = top.load(std::memory_order_relaxed); current_top < height;) {
+                if (top.compare_exchange_weak(current_top, height, std::memory_order_acq_rel)) break;
+            }
+
+            for (int level = 1; level < height; ++level) {
+                for (;;) {
+                    // Point the node at its successor; give up if an eraser has marked this level.
+                    Node *next = node->links()[level].load(std::memory_order_acquire);
+                    if (is_marked(next)) goto linked;
+                    if (next != succs[level] &&
+                        !node->links()[level].compare_exchange_strong(next, succs[level], std::memory_order_acq_rel)) {
+                        goto linked;
+                    }
+
+                    Node *expected = succs[level];
+                    if (preds[level]->compare_exchange_strong(expected, node, std::memory_order_acq_rel)) break;
+
+                    // Predecessors changed: search again, and stop if the node has been erased meanwhile.
+                    locate(key, preds, succs);
+                    if (succs[0] != node) goto linked;
+                }
+            }
+
+        linked:
+            release(node);
+            return true;
+        }
+
+        /**
+         * @brief Erases a key.
+         * @return true if this call erased the key, false if it was not present.
+         */
+        bool erase(const K &key) {
+            EpochReclamation::Guard guard;
+            std::atomic<Node *> *preds[max_level];
+            Node *succs[max_level];
+
+            if (!locate(key, preds, succs)) return false;
+            Node *node = succs[0];
+
+            for (int level = node->height - 1; level >= 1; --level) {
+                Node *next = node->links()[level].load(std::memory_order_acquire);
+                while (!is_marked(next)) {
+                    node->links()[level].compare_exchange_weak(next, marked(next), std::memory_order_acq_rel);
+                }
+            }
+
+            Node *next = node->links()[0].load(std::memory_order_acquire);
+            for (;;) {
+                if (is_marked(next)) return false; // Another thread erased it first.
+                if (node->links()[0].compare_exchange_weak(next, marked(next), std::memory_order_acq_rel)) break;
+            }
+
+            count.fetch_sub(1, std::memory_order_relaxed);
+            locate(key, preds, succs);
+            release(node);
+            return true;
+        }
+
+        /**
+         * @brief Finds the value of a key.
+         * @return A copy of the value, or an empty optional if the key is not present.
+         */
+        std::optional<V> find(const K &key) const {
+            EpochReclamation::Guard guard;
+            const Node *node = seek(key);
+            if (matches(node, key)) return node->value;
+            return std::nullopt;
+        }
+
+        bool contains(const K &key) const {
+            EpochReclamation::Guard guard;
+            return matches(seek(key), key);
+        }
+
+        /**
+         * @brief Finds the first entry whose key is not less than a key.
+         * @return A copy of the key and value, or an empty optional if there is none.
+         */
+        std::optional<std::pair<K, V> > lower_bound(const K &key) const {
+            EpochReclamation::Guard guard;
+            const Node *node = seek(key);
+            if (node == nullptr) return std::nullopt;
+            return std::pair<K, V>(node->key, node->value);
+        }
+
+        /**
+         * @brief Calls fn(key, value) for the entries with keys in [first, last), in order.
+         *
+         * Weakly consistent: see the class documentation. fn must not modify this list.
+         */
+        template<typename Fn>
+        void range(const K &first, const K &last, Fn fn) const {
+            EpochReclamation::Guard guard;
+
+            for (const Node *node = seek(first); node != nullptr && less(node->key, last);) {
+                Node *next = node->links()[0].load(std::memory_order_acquire);
+                if (!is_marked(next)) fn(node->key, node->value);
+                node = unmarked(next);
+            }
+        }
+
+        /**
+         * @brief Calls fn(key, value) for every entry, in order. Weakly consistent.
+         */
+        template<typename Fn>
+        void for_each(Fn fn) const {
+            EpochReclamation::Guard guard;
+
+            for (const Node *node = unmarked(head[0].load(std::memory_order_acquire)); node != nullptr;) {
+                Node *next = node->links()[0].load(std::memory_order_acquire);
+                if (!is_marked(next)) fn(node->key, node->value);
+                node = unmarked(next);
+            }
+        }
+
+        /**
+         * @brief Returns the number of keys. Exact only when no operation is in progress.
+         */
+        std::size_t size() const noexcept {
+            return count.load(std::memory_order_relaxed);
+        }
+
+        bool empty() const noexcept {
+            return size() == 0;
+        }
+    };
+} // DS
+
+#endif //CONCURRENTSKIPLIST_H
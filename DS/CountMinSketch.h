@@ -0,0 +1,376 @@
+#ifndef COUNTMINSKETCH_H
+#define COUNTMINSKETCH_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Hash.h"
+
+namespace DS {
+    /**
+     * @brief A Count-Min sketch with conservative update, for approximate frequency counts.
+     *
+     * The sketch is a depth x width grid of counters. Each key hits one counter per row
+     * and its estimated count is the minimum of those counters, so estimates never
+     * undercount. With width >= e / epsilon (a power of two) and depth = ceil(ln(1 / delta)), an
+     * estimate exceeds the true count by more than epsilon * total with probability at
+     * most delta.
+     *
+     * Conservative update only raises the counters that are below the key's new estimate,
+     * which keeps the overestimate much lower on skewed streams than the plain update.
+     *
+     * Sketches with the same shape can be merged by adding counters, so each thread can
+     * count into its own sketch and merge at the end.
+     */
+    class CountMinSketch {
+        static constexpr char magic[4] = {'D', 'S', 'C', 'M'};
+        static constexpr std::uint32_t format_version = 1;
+
+        std::size_t width; ///< Counters per row, a power of two.
+        std::size_t depth; ///< Number of rows.
+        std::vector<std::uint64_t> counters; ///< Row-major depth x width grid.
+        std::uint64_t total;
+
+        /**
+         * @brief Returns the counter index of the key in a row (Kirsch-Mitzenmacher double hashing).
+         */
+        std::size_t slot(const std::uint64_t hash, const std::size_t row) const {
+            const auto h1 = static_cast<std::uint32_t>(hash);
+            const auto h2 = static_cast<std::uint32_t>(hash >> 32) | 1u;
+            return row * width + ((h1 + row * h2) & (width - 1));
+        }
+
+        static void write_u32(std::vector<std::uint8_t> &out, const std::uint32_t value) {
+            for (std::size_t i = 0; i < 4; ++i) out.push_back(static_cast<std::uint8_t>(value >> (i * 8)));
+        }
+
+        static std::uint32_t read_u32(const std::uint8_t *in) {
+            std::uint32_t value = 0;
+            for (std::size_t i = 0; i < 4; ++i) value |= static_cast<std::uint32_t>(in[i]) << (i * 8);
+            return value;
+        }
+
+        static void write_u64(std::vector<std::uint8_t> &out, const std::uint64_t value) {
+            for (std::size_t i = 0; i < 8; ++i) out.push_back(static_cast<std::uint8_t>(value >> (i * 8)));
+        }
+
+        static std::uint64_t read_u64(const std::uint8_t *in) {
+            std::uint64_t value = 0;
+            for (std::size_t i = 0; i < 8; ++i) value |= static_cast<std::uint64_t>(in[i]) << (i * 8);
+            return value;
+        }
+
+        CountMinSketch(const std::size_t width, const std::size_t depth, std::nullptr_t)
+            : width(width), depth(depth), counters(width * depth, 0), total(0) {}
+
+    public:
+        /**
+         * @brief Constructs an empty sketch from error bounds.
+         *
+         * @param epsilon The additive error, as a fraction of the total count.
+         * @param delta The probability that an estimate exceeds the error bound.
+         * @throws std::runtime_error If either bound is not strictly between 0 and 1.
+         */
+        explicit CountMinSketch(const double epsilon = 0.001, const double delta = 0.001) : total(0) {
+            if (!(epsilon > 0.0 && epsilon < 1.0)) throw std::runtime_error("Invalid epsilon");
+            if (!(delta > 0.0 && delta < 1.0)) throw std::runtime_error("Invalid delta");
+
+            const auto min_width = static_cast<std::size_t>(std::ceil(std::exp(1.0) / epsilon));
+            width = 1;
+            while (width < min_width) width <<= 1;
+            depth = static_cast<std::size_t>(std::ceil(std::log(1.0 / delta)));
+            if (depth == 0) depth = 1;
+            counters.assign(width * depth, 0);
+        }
+
+        /**
+         * @brief Adds occurrences of a precomputed 64-bit hash.
+         *
+         * @param hash A well-mixed hash of the key.
+         * @param count The number of occurrences to add.
+         * @return The key's new estimated count.
+         */
+        std::uint64_t add_hash(const std::uint64_t hash, const std::uint64_t count = 1) {
+            const std::uint64_t target = estimate_hash(hash) + count;
+
+            for (std::size_t row = 0; row < depth; ++row) {
+                std::uint64_t &counter = counters[slot(hash, row)];
+                if (counter < target) counter = target;
+            }
+
+            total += count;
+            return target;
+        }
+
+        /**
+         * @brief Estimates the count of a precomputed 64-bit hash.
+         * @param hash A well-mixed hash of the key.
+         * @return An upper bound on the key's count.
+         */
+        std::uint64_t estimate_hash(const std::uint64_t hash) const {
+            std::uint64_t result = counters[slot(hash, 0)];
+            for (std::size_t row = 1; row < depth; ++row) {
+                const std::uint64_t counter = counters[slot(hash, row)];
+                if (counter < result) result = counter;
+            }
+            return result;
+        }
+
+        /**
+         * @brief Adds occurrences of a key.
+         *
+         * @param key The key to count; hashed with DS::Hash.
+         * @param count The number of occurrences to add.
+         * @return The key's new estimated count.
+         */
+        template<typename T>
+        std::uint64_t add(const T &key, const std::uint64_t count = 1) {
+            return add_hash(static_cast<std::uint64_t>(DS::Hash<T>{}(key)), count);
+        }
+
+        /**
+         * @brief Estimates the count of a key.
+         * @param key The key to look up; hashed with DS::Hash.
+         * @return An upper bound on the key's count.
+         */
+        template<typename T>
+        std::uint64_t estimate(const T &key) const {
+            return estimate_hash(static_cast<std::uint64_t>(DS::Hash<T>{}(key)));
+        }
+
+        /**
+         * @brief Adds the counts of another sketch to this one.
+         * @param other A sketch with the same width and depth.
+         * @throws std::runtime_error If the shapes differ.
+         */
+        void merge(const CountMinSketch &other) {
+            if (other.width != width || other.depth != depth) {
+                throw std::runtime_error("Cannot merge Count-Min sketches of different shapes");
+            }
+
+            for (std::size_t i = 0; i < counters.size(); ++i) {
+                counters[i] += other.counters[i];
+            }
+            total += other.total;
+        }
+
+        /**
+         * @brief Resets every counter to zero.
+         */
+        void clear() {
+            std::fill(counters.begin(), counters.end(), 0);
+            total = 0;
+        }
+
+        /**
+         * @brief Returns the sum of all counts added.
+         */
+        std::uint64_t get_total() const noexcept {
+            return total;
+        }
+
+        std::size_t get_width() const noexcept {
+            return width;
+        }
+
+        std::size_t get_depth() const noexcept {
+            return depth;
+        }
+
+        /**
+         * @brief Serializes the sketch to a portable byte string.
+         *
+         * Layout: "DSCM", u32 format version, then u64 width, depth, total and counters, all little-endian.
+         *
+         * @return The serialized sketch.
+         */
+        std::vector<std::uint8_t> serialize() const {
+            std::vector<std::uint8_t> out;
+            out.reserve(32 + counters.size() * 8);
+            for (const char c: magic) out.push_back(static_cast<std::uint8_t>(c));
+            write_u32(out, format_version);
+            write_u64(out, width);
+            write_u64(out, depth);
+            write_u64(out, total);
+            for (const std::uint64_t counter: counters) write_u64(out, counter);
+            return out;
+        }
+
+        /**
+         * @brief Rebuilds a sketch from the output of serialize().
+         * @param bytes The serialized sketch.
+         * @return The sketch.
+         * @throws std::runtime_error If the bytes are not a valid serialized sketch.
+         */
+        static CountMinSketch deserialize(const std::vector<std::uint8_t> &bytes) {
+            if (bytes.size() < 32 || std::memcmp(bytes.data(), magic, 4) != 0) {
+                throw std::runtime_error("Invalid Count-Min sketch data");
+            }
+            if (read_u32(bytes.data() + 4) != format_version) {
+                throw std::runtime_error("Unsupported Count-Min sketch version");
+            }
+
+            const std::uint64_t width = read_u64(bytes.data() + 8);
+            const std::uint64_t depth = read_u64(bytes.data() + 16);
+            if (width == 0 || (width & (width - 1)) != 0 || depth == 0 ||
+                (bytes.size() - 32) / 8 / width != depth || (bytes.size() - 32) != width * depth * 8) {
+                throw std::runtime_error("Invalid Count-Min sketch data");
+            }
+
+            CountMinSketch sketch(static_cast<std::size_t>(width), static_cast<std::size_t>(depth), nullptr);
+            sketch.total = read_u64(bytes.data() + 24);
+            for (std::size_t i = 0; i < sketch.counters.size(); ++i) {
+                sketch.counters[i] = read_u64(bytes.data() + 32 + i * 8);
+            }
+            return sketch;
+        }
+    };
+
+    /**
+     * @brief Tracks the k most frequent keys of a stream on top of a CountMinSketch.
+     *
+     * Candidates are kept in a min-heap ordered by their estimated count. A key that is
+     * not a candidate replaces the weakest candidate once its estimate is higher, so every
+     * key whose true count exceeds the k-th largest estimate is reported.
+     *
+     * @tparam T The type of the keys. Must be hashable with DS::Hash and std::hash.
+     */
+    template<typename T>
+    class HeavyHitters {
+        CountMinSketch sketch;
+        std::size_t k;
+        std::vector<std::pair<std::uint64_t, T> > heap; ///< Min-heap of (estimate, key).
+        std::unordered_map<T, std::size_t> positions; ///< Heap index of every candidate.
+
+        void swap_nodes(const std::size_t a, const std::size_t b) {
+            std::swap(heap[a], heap[b]);
+            positions[heap[a].second] = a;
+            positions[heap[b].second] = b;
+        }
+
+        void sift_down(std::size_t index) {
+            for (;;) {
+                const std::size_t left = 2 * index + 1;
+                const std::size_t right = left + 1;
+                std::size_t smallest = index;
+
+                if (left < heap.size() && heap[left].first < heap[smallest].first) smallest = left;
+                if (right < heap.size() && heap[right].first < heap[smallest].first) smallest = right;
+                if (smallest == index) return;
+
+                swap_nodes(index, smallest);
+                index = smallest;
+            }
+        }
+
+        void sift_up(std::size_t index) {
+            while (index > 0) {
+                const std::size_t parent = (index - 1) / 2;
+                if (!(heap[index].first < heap[parent].first)) return;
+                swap_nodes(index, parent);
+                index = parent;
+            }
+        }
+
+        void offer(const T &key, const std::uint64_t estimate) {
+            if (const auto found = positions.find(key); found != positions.end()) {
+                // Estimates only grow, so the candidate can only move away from the root.
+                heap[found->second].first = estimate;
+                sift_down(found->second);
+                return;
+            }
+
+            if (heap.size() < k) {
+                heap.emplace_back(estimate, key);
+                positions[key] = heap.size() - 1;
+                sift_up(heap.size() - 1);
+                return;
+            }
+
+            if (estimate > heap[0].first) {
+                positions.erase(heap[0].second);
+                heap[0] = {estimate, key};
+                positions[key] = 0;
+                sift_down(0);
+            }
+        }
+
+    public:
+        /**
+         * @brief Constructs an empty tracker.
+         *
+         * @param k The number of heavy hitters to keep.
+         * @param epsilon The additive error of the underlying sketch.
+         * @param delta The failure probability of the underlying sketch.
+         * @throws std::runtime_error If k is zero or the sketch bounds are invalid.
+         */
+        explicit HeavyHitters(const std::size_t k, const double epsilon = 0.001, const double delta = 0.001)
+            : sketch(epsilon, delta), k(k) {
+            if (k == 0) throw std::runtime_error("Invalid heavy hitter count");
+            heap.reserve(k);
+        }
+
+        /**
+         * @brief Adds occurrences of a key.
+         * @param key The key to count.
+         * @param count The number of occurrences to add.
+         */
+        void add(const T &key, const std::uint64_t count = 1) {
+            offer(key, sketch.add(key, count));
+        }
+
+        /**
+         * @brief Returns the tracked keys with their estimated counts, most frequent first.
+         */
+        std::vector<std::pair<T, std::uint64_t> > top() const {
+            std::vector<std::pair<T, std::uint64_t> > result;
+            result.reserve(heap.size());
+            for (const auto &[estimate, key]: heap) result.emplace_back(key, estimate);
+
+            std::sort(result.begin(), result.end(), [](const auto &a, const auto &b) {
+                return a.second > b.second;
+            });
+            return result;
+        }
+
+        /**
+         * @brief Merges another tracker's counts and candidates into this one.
+         *
+         * The sketches are added together and every candidate of both trackers is
+         * re-estimated against the merged sketch before the top k are kept.
+         *
+         * @param other A tracker built with the same k and sketch shape.
+         * @throws std::runtime_error If the sketch shapes differ.
+         */
+        void merge(const HeavyHitters &other) {
+            sketch.merge(other.sketch);
+
+            std::vector<T> candidates;
+            candidates.reserve(heap.size() + other.heap.size());
+            for (const auto &entry: heap) candidates.push_back(entry.second);
+            for (const auto &entry: other.heap) {
+                if (positions.find(entry.second) == positions.end()) candidates.push_back(entry.second);
+            }
+
+            heap.clear();
+            positions.clear();
+            for (const T &key: candidates) offer(key, sketch.estimate(key));
+        }
+
+        /**
+         * @brief Returns the underlying sketch, e.g. to query keys that are not tracked or to serialize it.
+         */
+        const CountMinSketch &get_sketch() const {
+            return sketch;
+        }
+    };
+} // DS
+
+#endif //COUNTMINSKETCH_H
@@ -0,0 +1,309 @@
+#ifndef CONCURRENTDLINKEDLIST_H
+#define CONCURRENTDLINKEDLIST_H
+
+#include <atomic>
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+#include "../EpochReclamation.h"
+
+namespace DS {
+    /**
+     * @brief A doubly linked list that many threads can modify at different positions at once.
+     *
+     * Every node has its own spinlock. Updates use optimistic, validation-based locking
+     * (the lazy list of Heller et al.): a thread finds its position without locks, locks
+     * the few nodes around it from left to right, checks that they are still adjacent and
+     * still in the list, and retries otherwise. Updates at different positions therefore
+     * run in parallel, and the fixed lock order rules out deadlocks.
+     *
+     * A removed node is first marked, then unlinked, and finally freed through
+     * EpochReclamation, so find(), contains() and for_each() take no locks at all: they
+     * follow next pointers and skip marked nodes.
+     *
+     * Node pointers returned by find(), push_back() and the insert functions stay
+     * allocated only while the calling thread holds an EpochReclamation::Guard; the
+     * functions themselves pin the thread for their own duration.
+     *
+     * @tparam T Type of the values stored in the list. Must be equality comparable.
+     */
+    template<typename T>
+    class ConcurrentDLinkedList {
+    public:
+        class Node {
+            const T value;
+            std::atomic<Node *> prev{nullptr};
+            std::atomic<Node *> next{nullptr};
+            std::atomic<bool> removed{false}; ///< Set, under the node's lock, before the node is unlinked.
+            std::atomic<bool> locked{false};
+
+            explicit Node(const T &value = T()) : value(value) {}
+
+            void lock() noexcept {
+                for (;;) {
+                    if (!locked.exchange(true, std::memory_order_acquire)) return;
+                    while (locked.load(std::memory_order_relaxed)) std::this_thread::yield();
+                }
+            }
+
+            void unlock() noexcept {
+                locked.store(false, std::memory_order_release);
+            }
+
+            friend class ConcurrentDLinkedList;
+
+        public:
+            T get_value() const {
+                return value;
+            }
+
+            /**
+             * @brief Checks whether the node has been removed from its list.
+             */
+            bool is_removed() const noexcept {
+                return removed.load(std::memory_order_acquire);
+            }
+        };
+
+    private:
+        Node *head; ///< Sentinel before the first node.
+        Node *tail; ///< Sentinel after the last node.
+        std::atomic<std::size_t> size{0};
+
+        static void destroy(void *pointer) {
+            delete static_cast<Node *>(pointer);
+        }
+
+        /**
+         * @brief Links a new node between two locked, adjacent nodes.
+         */
+        Node *link(Node *pred, Node *succ, const T &value) {
+            auto *node = new Node(value);
+            node->prev.store(pred, std::memory_order_relaxed);
+            node->next.store(succ, std::memory_order_relaxed);
+            // Publishing through pred->next makes the node visible to lock-free readers, and through
+            // succ->prev to threads that lock their way in from the right.
+            succ->prev.store(node, std::memory_order_release);
+            pred->next.store(node, std::memory_order_release);
+            size.fetch_add(1, std::memory_order_relaxed);
+            return node;
+        }
+
+        /**
+         * @brief Locks a node and its predecessor, left to right, once they are adjacent and both in the list.
+         * @return The locked predecessor, or nullptr if the node has been removed.
+         */
+        static Node *lock_with_predecessor(Node *node) {
+            for (;;) {
+                Node *pred = node->prev.load(std::memory_order_acquire);
+                pred->lock();
+                node->lock();
+                if (node->removed.load(std::memory_order_relaxed)) {
+                    node->unlock();
+                    pred->unlock();
+                    return nullptr;
+                }
+                if (!pred->removed.load(std::memory_order_relaxed) &&
+                    pred->next.load(std::memory_order_relaxed) == node) {
+                    return pred;
+                }
+                node->unlock();
+                pred->unlock();
+            }
+        }
+
+        /**
+         * @brief Returns the first node in the list holding a value, or nullptr.
+         */
+        Node *search(const T &value) const {
+            for (Node *node = head->next.load(std::memory_order_acquire); node != tail;
+                 node = node->next.load(std::memory_order_acquire)) {
+                if (!node->removed.load(std::memory_order_acquire) && node->value == value) return node;
+            }
+            return nullptr;
+        }
+
+    public:
+        /**
+         * @brief Constructor that initializes an empty list.
+         */
+        explicit ConcurrentDLinkedList() : head(new Node()), tail(new Node()) {
+            head->next.store(tail, std::memory_order_relaxed);
+            tail->prev.store(head, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Frees every node. Must not run concurrently with any other operation.
+         */
+        ~ConcurrentDLinkedList() {
+            for (Node *node = head; node != nullptr;) {
+                Node *next = node->next.load(std::memory_order_relaxed);
+                delete node;
+                node = next;
+            }
+        }
+
+        ConcurrentDLinkedList(const ConcurrentDLinkedList &) = delete;
+
+        ConcurrentDLinkedList &operator=(const ConcurrentDLinkedList &) = delete;
+
+        /**
+         * @brief Returns the number of nodes. Exact only when no update is in progress.
+         */
+        std::size_t get_size() const noexcept {
+            return size.load(std::memory_order_relaxed);
+        }
+
+        bool empty() const noexcept {
+            return get_size() == 0;
+        }
+
+        /**
+         * @brief Inserts a new node with the given value at the front of the list.
+         * @return The new node.
+         */
+        Node *insert_front(const T &value) {
+            EpochReclamation::Guard guard;
+            return insert_after(head, value);
+        }
+
+        /**
+         * @brief Inserts a new node with the given value at the back of the list.
+         * @return The new node.
+         */
+        Node *push_back(const T &value) {
+            EpochReclamation::Guard guard;
+            Node *pred = lock_with_predecessor(tail);
+            Node *node = link(pred, tail, value);
+            tail->unlock();
+            pred->unlock();
+            return node;
+        }
+
+        /**
+         * @brief Inserts a new node after the target node with the given value.
+         * @param target The node after which the new node is inserted.
+         * @param value The value to insert in the new node.
+         * @return The new node, or nullptr if the target has been removed.
+         * @throws std::runtime_error if the target node is null.
+         */
+        Node *insert_after(Node *const target, const T &value) {
+            if (target == nullptr) {
+                throw std::runtime_error("Target node cannot be null when inserting a new node.");
+            }
+
+            EpochReclamation::Guard guard;
+            target->lock();
+            if (target->removed.load(std::memory_order_relaxed)) {
+                target->unlock();
+                return nullptr;
+            }
+
+            // While the target is locked its successor cannot change.
+            Node *succ = target->next.load(std::memory_order_relaxed);
+            succ->lock();
+            Node *node = link(target, succ, value);
+            succ->unlock();
+            target->unlock();
+            return node;
+        }
+
+        /**
+         * @brief Removes a node.
+         * @param node The node to remove.
+         * @return true if this call removed the node, false if it had already been removed.
+         */
+        bool remove(Node *const node) {
+            if (node == nullptr || node == head || node == tail) return false;
+
+            EpochReclamation::Guard guard;
+            Node *pred = lock_with_predecessor(node);
+            if (pred == nullptr) return false;
+
+            // While the node is locked its successor cannot change.
+            Node *succ = node->next.load(std::memory_order_relaxed);
+            succ->lock();
+            node->removed.store(true, std::memory_order_release);
+            pred->next.store(succ, std::memory_order_release);
+            succ->prev.store(pred, std::memory_order_release);
+            size.fetch_sub(1, std::memory_order_relaxed);
+            succ->unlock();
+            node->unlock();
+            pred->unlock();
+
+            // Readers may still be standing on the node; its next pointer stays valid for them.
+            EpochReclamation::retire(node, &destroy);
+            return true;
+        }
+
+        /**
+         * @brief Removes the first node with the given value.
+         * @param value The value of the node to remove.
+         * @return true if a node was found and removed, false otherwise.
+         */
+        bool remove(const T &value) {
+            EpochReclamation::Guard guard;
+            for (;;) {
+                Node *node = search(value);
+                if (node == nullptr) return false;
+                if (remove(node)) return true;
+                // Another thread removed it first; look for the next match.
+            }
+        }
+
+        /**
+         * @brief Finds the first node with the given value, without locking.
+         * @param value The value to search for.
+         * @return A pointer to the node if found, nullptr otherwise.
+         */
+        Node *find(const T &value) const {
+            EpochReclamation::Guard guard;
+            return search(value);
+        }
+
+        /**
+         * @brief Checks whether a value is in the list, without locking.
+         */
+        bool contains(const T &value) const {
+            EpochReclamation::Guard guard;
+            return search(value) != nullptr;
+        }
+
+        /**
+         * @brief Calls fn(value) for every value from front to back, without locking.
+         *
+         * Weakly consistent: values inserted or removed during the traversal may or may not be visited.
+         */
+        template<typename Fn>
+        void for_each(Fn fn) const {
+            EpochReclamation::Guard guard;
+            for (Node *node = head->next.load(std::memory_order_acquire); node != tail;
+                 node = node->next.load(std::memory_order_acquire)) {
+                if (!node->removed.load(std::memory_order_acquire)) fn(node->value);
+            }
+        }
+
+        /**
+         * @brief Displays the contents of the list in a readable format.
+         * @remark Only works with a list based of one of the integral types (int, char, double...etc)
+         */
+        void show() const {
+            std::cout << "{";
+
+            bool first = true;
+            for_each([&first](const T &value) {
+                if (!first) {
+                    std::cout << ", ";
+                }
+                std::cout << value;
+                first = false;
+            });
+
+            std::cout << "}\n";
+        }
+    };
+} // DS
+
+#endif //CONCURRENTDLINKEDLIST_H
@@ -7,6 +7,7 @@
 
 #include <stdexcept>
 #include <cstddef>
+#include <iterator>
 
 #include "DNode.h"
 
@@ -27,6 +28,45 @@ namespace DS {
         std::size_t size; ///< Number of nodes currently in the list.
 
     public:
+        /**
+         * @brief A forward iterator over the values of the list, from front to back.
+         */
+        class ConstIterator {
+            const DNode<T> *node;
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T *;
+            using reference = const T &;
+
+            explicit ConstIterator(const DNode<T> *node = nullptr) : node(node) {}
+
+            const T &operator*() const {
+                return node->value;
+            }
+
+            ConstIterator &operator++() {
+                node = node->next;
+                return *this;
+            }
+
+            ConstIterator operator++(int) {
+                ConstIterator previous = *this;
+                node = node->next;
+                return previous;
+            }
+
+            bool operator==(const ConstIterator &other) const {
+                return node == other.node;
+            }
+
+            bool operator!=(const ConstIterator &other) const {
+                return node != other.node;
+            }
+        };
+
         /**
          * @brief Constructor that initializes an empty list.
          */
@@ -79,6 +119,14 @@ namespace DS {
             return size;
         }
 
+        ConstIterator begin() const {
+            return ConstIterator(head);
+        }
+
+        ConstIterator end() const {
+            return ConstIterator(nullptr);
+        }
+
         /**
          * @brief Inserts a new node with the given value at the front of the list.
          * @param value The value to insert.
@@ -0,0 +1,221 @@
+#ifndef EPOCHRECLAMATION_H
+#define EPOCHRECLAMATION_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "ThreadRegistry.h"
+
+namespace DS {
+    /**
+     * @brief Epoch-based reclamation (EBR) of memory shared by lock-free data structures.
+     *
+     * A thread pins itself with a Guard before it reads shared pointers and unpins when
+     * the guard is destroyed. A node that has been unlinked from a structure is handed to
+     * retire() instead of being deleted; it is deleted once every thread that might still
+     * hold a pointer to it has unpinned.
+     *
+     * Each thread owns a record holding the epoch it is pinned in. The global epoch only
+     * advances when every pinned thread has observed it, so a node retired in epoch e can
+     * be freed once the global epoch reaches e + 2. Retired nodes wait in three per-thread
+     * limbo lists, one per epoch modulo 3.
+     *
+     * Retirement is amortized: a thread only tries to advance the epoch and free its
+     * limbo lists every collect_interval retirements. When a thread exits, the nodes
+     * still waiting in its limbo lists are handed to a shared orphan list that other
+     * threads free during their collections, so thread churn does not strand garbage;
+     * the record itself is reused by the next new thread. Nodes still waiting when the
+     * program exits are freed then.
+     *
+     * @see HazardPointers for a scheme that bounds the number of unreclaimed nodes even
+     *      when a thread stalls inside a critical section.
+     */
+    class EpochReclamation {
+        static constexpr unsigned collect_interval = 64; ///< Retirements between two collection attempts.
+
+        struct Retired {
+            void *pointer;
+            void (*deleter)(void *);
+        };
+
+        struct alignas(64) Record : ThreadRecord<Record> {
+            std::atomic<std::uint64_t> state{0}; ///< (epoch << 1) | 1 while pinned, 0 otherwise.
+
+            unsigned nesting = 0;
+            unsigned retired_since_collect = 0;
+            std::vector<Retired> limbo[3];
+            std::uint64_t limbo_epoch[3] = {0, 0, 0}; ///< Epoch in which the nodes of each list were retired.
+
+            ~Record() {
+                for (std::vector<Retired> &list: limbo) free_all(list);
+            }
+
+            /**
+             * @brief Unpins the exiting thread and hands its limbo lists to the orphan list.
+             */
+            void release() {
+                state.store(0, std::memory_order_release);
+                for (std::size_t i = 0; i < 3; ++i) {
+                    if (limbo[i].empty()) continue;
+                    adopt(new Orphan{std::move(limbo[i]), limbo_epoch[i], nullptr});
+                    limbo[i].clear();
+                }
+                retired_since_collect = 0;
+            }
+        };
+
+        /**
+         * @brief A limbo list left behind by an exited thread.
+         */
+        struct Orphan {
+            std::vector<Retired> nodes;
+            std::uint64_t epoch;
+            Orphan *next;
+        };
+
+        struct Registry {
+            std::atomic<std::uint64_t> epoch{0};
+            ThreadRegistry<Record> threads;
+            std::atomic<Orphan *> orphans{nullptr};
+
+            ~Registry() {
+                for (Orphan *orphan = orphans.load(); orphan != nullptr;) {
+                    Orphan *next = orphan->next;
+                    free_all(orphan->nodes);
+                    delete orphan;
+                    orphan = next;
+                }
+            }
+        };
+
+        static Registry &registry() {
+            static Registry instance;
+            return instance;
+        }
+
+        static Record &local() {
+            return registry().threads.local();
+        }
+
+        static void adopt(Orphan *orphan) {
+            std::atomic<Orphan *> &orphans = registry().orphans;
+            Orphan *head = orphans.load(std::memory_order_relaxed);
+            do {
+                orphan->next = head;
+            } while (!orphans.compare_exchange_weak(head, orphan, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        static void free_all(std::vector<Retired> &list) {
+            // Deleters may retire more nodes, so detach the list before running them.
+            std::vector<Retired> detached;
+            detached.swap(list);
+            for (const Retired &retired: detached) retired.deleter(retired.pointer);
+        }
+
+        /**
+         * @brief Advances the global epoch if every pinned thread has observed the current one.
+         */
+        static void try_advance() {
+            // Pairs with the fence in Guard(): a pin published before the scan is seen by it.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            Registry &shared = registry();
+            std::uint64_t epoch = shared.epoch.load(std::memory_order_acquire);
+
+            for (Record *record = shared.threads.first(); record != nullptr;
+                 record = record->next) {
+                const std::uint64_t state = record->state.load(std::memory_order_acquire);
+                if ((state & 1) && (state >> 1) != epoch) return;
+            }
+            shared.epoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_acq_rel);
+        }
+
+        static void collect(Record &record) {
+            record.retired_since_collect = 0;
+            try_advance();
+
+            Registry &shared = registry();
+            const std::uint64_t epoch = shared.epoch.load(std::memory_order_acquire);
+            for (std::size_t i = 0; i < 3; ++i) {
+                if (!record.limbo[i].empty() && record.limbo_epoch[i] + 2 <= epoch) free_all(record.limbo[i]);
+            }
+
+            // Take over the orphaned lists, free the expired ones and hand the others back.
+            if (shared.orphans.load(std::memory_order_relaxed) == nullptr) return;
+            for (Orphan *orphan = shared.orphans.exchange(nullptr, std::memory_order_acquire); orphan != nullptr;) {
+                Orphan *next = orphan->next;
+                if (orphan->epoch + 2 <= epoch) {
+                    free_all(orphan->nodes);
+                    delete orphan;
+                } else {
+                    adopt(orphan);
+                }
+                orphan = next;
+            }
+        }
+
+    public:
+        /**
+         * @brief Pins the calling thread for the lifetime of the guard. Guards may be nested.
+         */
+        class Guard {
+            Record &record;
+
+        public:
+            Guard() : record(local()) {
+                if (record.nesting++ == 0) {
+                    const std::uint64_t epoch = registry().epoch.load(std::memory_order_relaxed);
+                    record.state.store((epoch << 1) | 1, std::memory_order_relaxed);
+                    // The pin must be visible before any shared pointer is read.
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                }
+            }
+
+            ~Guard() {
+                if (--record.nesting == 0) record.state.store(0, std::memory_order_release);
+            }
+
+            Guard(const Guard &) = delete;
+
+            Guard &operator=(const Guard &) = delete;
+        };
+
+        /**
+         * @brief Defers freeing a node until no pinned thread can still reference it.
+         *
+         * The node must already be unreachable for threads that pin themselves from now on.
+         *
+         * @param pointer The node.
+         * @param deleter The function that frees the node.
+         */
+        static void retire(void *pointer, void (*deleter)(void *)) {
+            Record &record = local();
+            // Pairs with the fence in Guard(): either a reader pinned in a later epoch sees the
+            // caller's unlink, or the node is tagged with an epoch no older than that reader's.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const std::uint64_t epoch = registry().epoch.load(std::memory_order_acquire);
+            const std::size_t bucket = epoch % 3;
+
+            // The list still holds nodes from epoch - 3 or earlier, which are safe to free.
+            if (record.limbo_epoch[bucket] != epoch) {
+                free_all(record.limbo[bucket]);
+                record.limbo_epoch[bucket] = epoch;
+            }
+            record.limbo[bucket].push_back({pointer, deleter});
+
+            if (++record.retired_since_collect >= collect_interval) collect(record);
+        }
+
+        /**
+         * @brief Defers deleting an object allocated with new.
+         */
+        template<typename T>
+        static void retire(T *pointer) {
+            retire(pointer, [](void *p) { delete static_cast<T *>(p); });
+        }
+    };
+} // DS
+
+#endif //EPOCHRECLAMATION_H
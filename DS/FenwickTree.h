@@ -0,0 +1,153 @@
+#ifndef FENWICKTREE_H
+#define FENWICKTREE_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "Array.h"
+
+namespace DS {
+    /**
+     * @brief A Fenwick (binary indexed) tree for prefix sums with point updates.
+     *
+     * Both add() and prefix_sum() run in O(log n) over a single flat array. Building from
+     * existing values takes O(n).
+     *
+     * @tparam T The type of the values. Must support +, - and value-initialization to zero.
+     */
+    template<typename T>
+    class FenwickTree {
+        std::vector<T> tree; ///< 1-indexed; tree[i] holds the sum of the (i & -i) values ending at i - 1.
+
+        void build() {
+            const std::size_t n = size();
+            for (std::size_t i = 1; i <= n; ++i) {
+                const std::size_t parent = i + (i & (~i + 1));
+                if (parent <= n) tree[parent] = tree[parent] + tree[i];
+            }
+        }
+
+    public:
+        /**
+         * @brief Constructs a tree of n zeros.
+         * @param n The number of values.
+         */
+        explicit FenwickTree(const std::size_t n = 0) : tree(n + 1, T()) {}
+
+        /**
+         * @brief Builds a tree from a DS::Array in O(n).
+         * @param array The initial values.
+         */
+        explicit FenwickTree(const Array<T> &array) : tree(static_cast<std::size_t>(array.size()) + 1, T()) {
+            for (int i = 0; i < array.size(); ++i) tree[static_cast<std::size_t>(i) + 1] = array.at(i);
+            build();
+        }
+
+        /**
+         * @brief Builds a tree from a plain array in O(n).
+         * @param values Pointer to the first value.
+         * @param n The number of values.
+         */
+        FenwickTree(const T *values, const std::size_t n) : tree(n + 1, T()) {
+            for (std::size_t i = 0; i < n; ++i) tree[i + 1] = values[i];
+            build();
+        }
+
+        /**
+         * @brief Returns the number of values.
+         */
+        std::size_t size() const noexcept {
+            return tree.size() - 1;
+        }
+
+        bool empty() const noexcept {
+            return size() == 0;
+        }
+
+        /**
+         * @brief Adds a delta to the value at an index.
+         * @param index The index of the value (0-indexed).
+         * @param delta The amount to add.
+         * @throws std::out_of_range If the index is out of bounds.
+         */
+        void add(const std::size_t index, const T &delta) {
+            if (index >= size()) throw std::out_of_range("Index out of bounds");
+
+            for (std::size_t i = index + 1; i < tree.size(); i += i & (~i + 1)) {
+                tree[i] = tree[i] + delta;
+            }
+        }
+
+        /**
+         * @brief Returns the sum of the values in [0, end).
+         * @param end The exclusive end index.
+         * @throws std::out_of_range If end is greater than size().
+         */
+        T prefix_sum(const std::size_t end) const {
+            if (end > size()) throw std::out_of_range("Index out of bounds");
+
+            T sum = T();
+            for (std::size_t i = end; i > 0; i -= i & (~i + 1)) {
+                sum = sum + tree[i];
+            }
+            return sum;
+        }
+
+        /**
+         * @brief Returns the sum of the values in [begin, end).
+         * @param begin The inclusive start index.
+         * @param end The exclusive end index.
+         * @throws std::out_of_range If the range is invalid.
+         */
+        T range_sum(const std::size_t begin, const std::size_t end) const {
+            if (begin > end) throw std::out_of_range("Invalid range");
+            return prefix_sum(end) - prefix_sum(begin);
+        }
+
+        /**
+         * @brief Returns the value at an index.
+         * @param index The index of the value (0-indexed).
+         * @throws std::out_of_range If the index is out of bounds.
+         */
+        T get(const std::size_t index) const {
+            return range_sum(index, index + 1);
+        }
+
+        /**
+         * @brief Replaces the value at an index.
+         * @param index The index of the value (0-indexed).
+         * @param value The new value.
+         * @throws std::out_of_range If the index is out of bounds.
+         */
+        void set(const std::size_t index, const T &value) {
+            add(index, value - get(index));
+        }
+
+        /**
+         * @brief Finds the shortest prefix whose sum reaches a target, in O(log n).
+         *
+         * Requires every value to be non-negative, so that prefix sums are non-decreasing.
+         *
+         * @param target The sum to reach.
+         * @return The smallest end such that prefix_sum(end) >= target, or size() + 1 if no prefix reaches it.
+         */
+        std::size_t lower_bound(T target) const {
+            if (!(T() < target)) return 0;
+
+            std::size_t step = 1;
+            while (step * 2 <= size()) step *= 2;
+
+            std::size_t position = 0;
+            for (; step > 0; step /= 2) {
+                if (position + step <= size() && tree[position + step] < target) {
+                    position += step;
+                    target = target - tree[position];
+                }
+            }
+            return position + 1;
+        }
+    };
+} // DS
+
+#endif //FENWICKTREE_H
@@ -0,0 +1,140 @@
+#ifndef FILTEREDARRAY_H
+#define FILTEREDARRAY_H
+
+#include <cstddef>
+
+#include "Array.h"
+#include "BloomFilter.h"
+
+namespace DS {
+    /**
+     * @brief A DS::Array that keeps a Bloom filter of its values to answer misses in O(1).
+     *
+     * Every value added through this class is also added to a BloomFilter. find() and
+     * contains() first ask the filter and only scan the array when the value may be
+     * present, so lookups of absent values skip the linear scan in all but a
+     * false_positive_rate fraction of cases.
+     *
+     * Bloom filters cannot forget keys: removed values stay in the filter and only raise
+     * the false positive rate. Call rebuild_filter() after many removals. The filter is
+     * rebuilt twice as large whenever the array outgrows the size it was built for.
+     *
+     * @tparam T The type of elements stored in the array. Must be hashable with DS::Hash.
+     */
+    template<typename T>
+    class FilteredArray {
+        Array<T> array;
+        BloomFilter filter;
+        std::size_t filter_items; ///< The number of values the current filter was sized for.
+        double false_positive_rate;
+
+    public:
+        /**
+         * @brief Constructs an empty array.
+         *
+         * @param expected_items The number of values to size the filter for.
+         * @param false_positive_rate The target false positive rate of the filter.
+         * @throws std::runtime_error If the rate is not strictly between 0 and 1.
+         */
+        explicit FilteredArray(const std::size_t expected_items = 1024, const double false_positive_rate = 0.01)
+            : filter(expected_items, false_positive_rate), filter_items(expected_items == 0 ? 1 : expected_items),
+              false_positive_rate(false_positive_rate) {}
+
+        // DS::Array has no copy constructor, so a copy would share and double-free its buffer.
+        FilteredArray(const FilteredArray &) = delete;
+
+        FilteredArray &operator=(const FilteredArray &) = delete;
+
+        bool empty() const {
+            return array.empty();
+        }
+
+        int size() const {
+            return array.size();
+        }
+
+        T at(const int index) const {
+            return array.at(index);
+        }
+
+        T operator[](const int index) const {
+            return array.at(index);
+        }
+
+        /**
+         * @brief Appends a value to the array and adds it to the filter.
+         * @param value The value to append.
+         */
+        void push_back(const T &value) {
+            array.push_back(value);
+
+            if (static_cast<std::size_t>(array.size()) > filter_items) {
+                filter_items *= 2;
+                rebuild_filter();
+            } else {
+                filter.insert(value);
+            }
+        }
+
+        /**
+         * @brief Finds the first occurrence of a value.
+         * @param value The value to search for.
+         * @return The index of the value, or -1 if not found. Definite misses return without scanning.
+         */
+        int find(const T &value) {
+            if (!filter.may_contain(value)) return -1;
+            return array.find(value);
+        }
+
+        /**
+         * @brief Checks whether a value is in the array.
+         * @param value The value to search for.
+         * @return true if the value is present, false otherwise.
+         */
+        bool contains(const T &value) {
+            return find(value) != -1;
+        }
+
+        /**
+         * @brief Removes the first occurrence of a value, if any. The filter is left unchanged.
+         * @param value The value to remove.
+         */
+        void remove(const T &value) {
+            if (const int found_at = find(value); found_at != -1) {
+                array.remove_at(found_at);
+            }
+        }
+
+        /**
+         * @brief Removes elements by index. The filter is left unchanged.
+         * @param index The index of the first element to remove.
+         * @param length The number of elements to remove.
+         */
+        void remove_at(const int index, const int length = 1) {
+            array.remove_at(index, length);
+        }
+
+        /**
+         * @brief Rebuilds the filter from the current contents, dropping removed values.
+         */
+        void rebuild_filter() {
+            filter = BloomFilter(filter_items, false_positive_rate);
+            for (int i = 0; i < array.size(); ++i) {
+                filter.insert(array.at(i));
+            }
+        }
+
+        /**
+         * @brief Returns the filter, e.g. to serialize it or merge it into another one.
+         */
+        const BloomFilter &get_filter() const {
+            return filter;
+        }
+
+        void show() {
+            array.show();
+        }
+    };
+} // DS
+
+#endif //FILTEREDARRAY_H
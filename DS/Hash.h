@@ -0,0 +1,44 @@
+#ifndef HASH_H
+#define HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace DS {
+    /**
+     * @brief Finalizes a 64-bit value so that every input bit affects every output bit.
+     *
+     * This is the SplitMix64 finalizer. It is used to scramble weak hashes (for example
+     * the identity hash that std::hash uses for integers) before their bits are used to
+     * pick shards, buckets or filter blocks.
+     *
+     * @param x The value to mix.
+     * @return The mixed value.
+     */
+    inline std::uint64_t mix64(std::uint64_t x) noexcept {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return x;
+    }
+
+    /**
+     * @brief Default hasher for the hashed containers in DS.
+     *
+     * Wraps std::hash and passes its result through mix64(), so the high and low bits
+     * of the hash are both usable.
+     *
+     * @tparam T The type of the keys to hash.
+     */
+    template<typename T>
+    struct Hash {
+        std::size_t operator()(const T &value) const {
+            return static_cast<std::size_t>(mix64(static_cast<std::uint64_t>(std::hash<T>{}(value))));
+        }
+    };
+} // DS
+
+#endif //HASH_H
@@ -0,0 +1,251 @@
+#ifndef HAZARDPOINTERS_H
+#define HAZARDPOINTERS_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "ThreadRegistry.h"
+
+namespace DS {
+    /**
+     * @brief Hazard-pointer reclamation of memory shared by lock-free data structures (Michael, 2004).
+     *
+     * Before dereferencing a shared node, a thread publishes its address in one of its
+     * hazard slots and checks that the node is still reachable. A node that has been
+     * unlinked is handed to retire(); it is freed by a later scan that finds no hazard
+     * slot pointing to it.
+     *
+     * Unlike EpochReclamation, a stalled thread only keeps the few nodes its own slots
+     * point to alive, so the number of retired but unfreed nodes stays bounded by about
+     * scan_threshold per thread plus the number of hazard slots. The price is a store
+     * and a full fence for every protected pointer, instead of one per critical section.
+     *
+     * Records are reused after their thread exits; the nodes it had retired but not yet
+     * freed go to a shared orphan list that the next scans take care of.
+     */
+    class HazardPointers {
+    public:
+        static constexpr std::size_t slots_per_thread = 4;
+
+    private:
+        static constexpr std::size_t scan_threshold = 64; ///< Retired nodes per thread that trigger a scan.
+
+        struct Retired {
+            void *pointer;
+            void (*deleter)(void *);
+        };
+
+        struct alignas(64) Record : ThreadRecord<Record> {
+            std::atomic<void *> hazards[slots_per_thread] = {};
+
+            unsigned used = 0; ///< Bit i is set while slot i belongs to a HazardPointer.
+            std::vector<Retired> retired;
+
+            ~Record() {
+                free_all(retired);
+            }
+
+            /**
+             * @brief Clears the exiting thread's hazards and hands its retired nodes to the orphan list.
+             */
+            void release() {
+                for (std::atomic<void *> &hazard: hazards) hazard.store(nullptr, std::memory_order_release);
+                used = 0;
+                if (!retired.empty()) {
+                    adopt(new Orphan{std::move(retired), nullptr});
+                    retired.clear();
+                }
+            }
+        };
+
+        /**
+         * @brief The retired nodes of an exited thread, waiting for a scan.
+         */
+        struct Orphan {
+            std::vector<Retired> nodes;
+            Orphan *next;
+        };
+
+        struct Registry {
+            ThreadRegistry<Record> threads;
+            std::atomic<Orphan *> orphans{nullptr};
+
+            ~Registry() {
+                for (Orphan *orphan = orphans.load(); orphan != nullptr;) {
+                    Orphan *next = orphan->next;
+                    free_all(orphan->nodes);
+                    delete orphan;
+                    orphan = next;
+                }
+            }
+        };
+
+        static Registry &registry() {
+            static Registry instance;
+            return instance;
+        }
+
+        static Record &local() {
+            return registry().threads.local();
+        }
+
+        static void adopt(Orphan *orphan) {
+            std::atomic<Orphan *> &orphans = registry().orphans;
+            Orphan *head = orphans.load(std::memory_order_relaxed);
+            do {
+                orphan->next = head;
+            } while (!orphans.compare_exchange_weak(head, orphan, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        static void free_all(std::vector<Retired> &list) {
+            // Deleters may retire more nodes, so detach the list before running them.
+            std::vector<Retired> detached;
+            detached.swap(list);
+            for (const Retired &retired: detached) retired.deleter(retired.pointer);
+        }
+
+        /**
+         * @brief Frees every retired node of the calling thread, and of exited threads, that no hazard slot points to.
+         */
+        static void scan(Record &record) {
+            Registry &shared = registry();
+
+            // Pick up the nodes of exited threads.
+            for (Orphan *orphan = shared.orphans.exchange(nullptr, std::memory_order_acquire); orphan != nullptr;) {
+                Orphan *next = orphan->next;
+                record.retired.insert(record.retired.end(), orphan->nodes.begin(), orphan->nodes.end());
+                delete orphan;
+                orphan = next;
+            }
+
+            // Pairs with the fence in protect(): a hazard published before the node was unlinked is seen here.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            std::vector<void *> hazards;
+            hazards.reserve(shared.threads.size() * slots_per_thread);
+            for (Record *other = shared.threads.first(); other != nullptr; other = other->next) {
+                for (const std::atomic<void *> &hazard: other->hazards) {
+                    void *pointer = hazard.load(std::memory_order_acquire);
+                    if (pointer != nullptr) hazards.push_back(pointer);
+                }
+            }
+            std::sort(hazards.begin(), hazards.end());
+
+            std::vector<Retired> candidates;
+            candidates.swap(record.retired);
+            for (const Retired &retired: candidates) {
+                if (std::binary_search(hazards.begin(), hazards.end(), retired.pointer)) {
+                    record.retired.push_back(retired);
+                } else {
+                    retired.deleter(retired.pointer);
+                }
+            }
+        }
+
+    public:
+        /**
+         * @brief Owns one hazard slot of the calling thread for its lifetime.
+         *
+         * At most slots_per_thread hazard pointers may exist per thread at a time.
+         */
+        class HazardPointer {
+            Record &record;
+            std::size_t slot;
+
+        public:
+            /**
+             * @throws std::runtime_error If the calling thread has no free hazard slot.
+             */
+            HazardPointer() : record(local()), slot(0) {
+                while (slot < slots_per_thread && (record.used >> slot) & 1) ++slot;
+                if (slot == slots_per_thread) throw std::runtime_error("No free hazard slot");
+                record.used |= 1U << slot;
+            }
+
+            ~HazardPointer() {
+                reset();
+                record.used &= ~(1U << slot);
+            }
+
+            HazardPointer(const HazardPointer &) = delete;
+
+            HazardPointer &operator=(const HazardPointer &) = delete;
+
+            /**
+             * @brief Loads a shared pointer and protects the node it points to.
+             *
+             * The node stays allocated until the slot is reset or reused, provided it is
+             * only retired after being unlinked from source.
+             *
+             * @param source The shared pointer.
+             * @return The protected pointer, as loaded from source.
+             */
+            template<typename T>
+            T *protect(const std::atomic<T *> &source) noexcept {
+                T *pointer = source.load(std::memory_order_relaxed);
+                for (;;) {
+                    record.hazards[slot].store(pointer, std::memory_order_relaxed);
+                    // The hazard must be visible before source is checked again.
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    T *current = source.load(std::memory_order_acquire);
+                    if (current == pointer) return pointer;
+                    pointer = current;
+                }
+            }
+
+            /**
+             * @brief Protects a pointer that the caller knows is still reachable, for example a pointer that is already protected.
+             */
+            template<typename T>
+            void set(T *pointer) noexcept {
+                record.hazards[slot].store(pointer, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+            }
+
+            /**
+             * @brief Stops protecting the node.
+             */
+            void reset() noexcept {
+                record.hazards[slot].store(nullptr, std::memory_order_release);
+            }
+        };
+
+        /**
+         * @brief Defers freeing a node until no hazard slot points to it.
+         *
+         * The node must already be unreachable for threads that protect pointers from now on.
+         *
+         * @param pointer The node.
+         * @param deleter The function that frees the node.
+         */
+        static void retire(void *pointer, void (*deleter)(void *)) {
+            Record &record = local();
+            record.retired.push_back({pointer, deleter});
+
+            // Scanning only when the list outgrows the number of hazards amortizes it to O(1) per node.
+            const std::size_t hazards = registry().threads.size() * slots_per_thread;
+            if (record.retired.size() >= std::max(scan_threshold, 2 * hazards)) scan(record);
+        }
+
+        /**
+         * @brief Defers deleting an object allocated with new.
+         */
+        template<typename T>
+        static void retire(T *pointer) {
+            retire(pointer, [](void *p) { delete static_cast<T *>(p); });
+        }
+
+        /**
+         * @brief Frees whatever the calling thread has retired that is no longer protected.
+         */
+        static void reclaim() {
+            scan(local());
+        }
+    };
+} // DS
+
+#endif //HAZARDPOINTERS_H
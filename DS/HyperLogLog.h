@@ -0,0 +1,349 @@
+#ifndef HYPERLOGLOG_H
+#define HYPERLOGLOG_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "Hash.h"
+
+namespace DS {
+    /**
+     * @brief A HyperLogLog sketch that estimates the number of distinct keys in a stream.
+     *
+     * The sketch uses 2^precision registers. The standard error of the estimate is about
+     * 1.04 / sqrt(2^precision), e.g. 0.81% at the default precision of 14 (16 KiB).
+     *
+     * While few registers are set the sketch stays sparse: it keeps a sorted list of
+     * (register, rank) pairs plus a small unsorted buffer, which costs far less than the
+     * dense array for small streams. It switches to the dense register array once the
+     * sparse list would be larger than a quarter of it.
+     *
+     * Estimates use Ertl's improved estimator, which is unbiased over the whole range
+     * without the empirical bias tables of HyperLogLog++.
+     *
+     * Sketches with the same precision can be merged (register-wise max, vectorized with
+     * SSE2), so each thread can count into its own sketch and merge at the end.
+     */
+    class HyperLogLog {
+        static constexpr char magic[4] = {'D', 'S', 'H', 'L'};
+        static constexpr std::uint32_t format_version = 1;
+        static constexpr std::size_t buffer_limit = 256; ///< Unsorted sparse entries kept before a compaction.
+
+        std::uint8_t precision;
+        std::vector<std::uint8_t> registers; ///< Dense registers; empty while the sketch is sparse.
+        std::vector<std::uint32_t> sparse; ///< Sorted (index << 8 | rank), one entry per index.
+        std::vector<std::uint32_t> buffer; ///< Unsorted sparse entries not yet merged into sparse.
+
+        std::size_t register_count() const {
+            return std::size_t{1} << precision;
+        }
+
+        bool is_sparse() const {
+            return registers.empty();
+        }
+
+        /**
+         * @brief Merges unsorted entries into a sorted entry list, keeping the largest rank per index.
+         */
+        static std::vector<std::uint32_t> merge_entries(const std::vector<std::uint32_t> &sorted,
+                                                        std::vector<std::uint32_t> unsorted) {
+            std::vector<std::uint32_t> merged;
+            merged.reserve(sorted.size() + unsorted.size());
+            std::sort(unsorted.begin(), unsorted.end());
+            std::merge(sorted.begin(), sorted.end(), unsorted.begin(), unsorted.end(), std::back_inserter(merged));
+
+            // Entries sort by index, then by rank: keep the last entry of every index.
+            std::size_t out = 0;
+            for (std::size_t i = 0; i < merged.size(); ++i) {
+                if (i + 1 < merged.size() && (merged[i + 1] >> 8) == (merged[i] >> 8)) continue;
+                merged[out++] = merged[i];
+            }
+            merged.resize(out);
+            return merged;
+        }
+
+        /**
+         * @brief Sorts the buffer into the sparse list.
+         */
+        void compact() {
+            if (buffer.empty()) return;
+            sparse = merge_entries(sparse, std::move(buffer));
+            buffer.clear();
+        }
+
+        /**
+         * @brief Returns the sparse list with the buffer merged in, leaving the sketch untouched so const readers do not race.
+         */
+        std::vector<std::uint32_t> sparse_entries() const {
+            if (buffer.empty()) return sparse;
+            return merge_entries(sparse, buffer);
+        }
+
+        void to_dense() {
+            compact();
+            registers.assign(register_count(), 0);
+            for (const std::uint32_t entry: sparse) {
+                registers[entry >> 8] = static_cast<std::uint8_t>(entry & 0xff);
+            }
+            sparse.clear();
+            sparse.shrink_to_fit();
+            buffer.clear();
+            buffer.shrink_to_fit();
+        }
+
+        void set_register(const std::uint32_t index, const std::uint8_t rank) {
+            if (!is_sparse()) {
+                if (registers[index] < rank) registers[index] = rank;
+                return;
+            }
+
+            buffer.push_back(index << 8 | rank);
+            if (buffer.size() >= buffer_limit) {
+                compact();
+                if (sparse.size() * sizeof(std::uint32_t) > register_count() / 4) to_dense();
+            }
+        }
+
+        /**
+         * @brief Ertl's sigma function, used to correct for empty registers.
+         */
+        static double sigma(double x) {
+            if (x == 1.0) return std::numeric_limits<double>::infinity();
+            double y = 1.0;
+            double z = x;
+            for (;;) {
+                x *= x;
+                const double previous = z;
+                z += x * y;
+                y += y;
+                if (previous == z) return z;
+            }
+        }
+
+        /**
+         * @brief Ertl's tau function, used to correct for saturated registers.
+         */
+        static double tau(double x) {
+            if (x == 0.0 || x == 1.0) return 0.0;
+            double y = 1.0;
+            double z = 1.0 - x;
+            for (;;) {
+                x = std::sqrt(x);
+                const double previous = z;
+                y *= 0.5;
+                z -= (1.0 - x) * (1.0 - x) * y;
+                if (previous == z) return z / 3.0;
+            }
+        }
+
+        static void write_u32(std::vector<std::uint8_t> &out, const std::uint32_t value) {
+            for (std::size_t i = 0; i < 4; ++i) out.push_back(static_cast<std::uint8_t>(value >> (i * 8)));
+        }
+
+        static std::uint32_t read_u32(const std::uint8_t *in) {
+            std::uint32_t value = 0;
+            for (std::size_t i = 0; i < 4; ++i) value |= static_cast<std::uint32_t>(in[i]) << (i * 8);
+            return value;
+        }
+
+    public:
+        /**
+         * @brief Constructs an empty sketch.
+         * @param precision The number of index bits, between 4 and 18.
+         * @throws std::runtime_error If the precision is out of range.
+         */
+        explicit HyperLogLog(const std::uint8_t precision = 14) : precision(precision) {
+            if (precision < 4 || precision > 18) throw std::runtime_error("Invalid HyperLogLog precision");
+        }
+
+        /**
+         * @brief Adds a precomputed 64-bit hash to the sketch.
+         * @param hash A well-mixed hash of the key.
+         */
+        void insert_hash(const std::uint64_t hash) {
+            const auto index = static_cast<std::uint32_t>(hash >> (64 - precision));
+            const std::uint64_t rest = hash << precision;
+            const int max_rank = 64 - precision + 1;
+            const int rank = rest == 0 ? max_rank : std::min(__builtin_clzll(rest) + 1, max_rank);
+            set_register(index, static_cast<std::uint8_t>(rank));
+        }
+
+        /**
+         * @brief Adds a key to the sketch.
+         * @param key The key to add; hashed with DS::Hash.
+         */
+        template<typename T>
+        void insert(const T &key) {
+            insert_hash(static_cast<std::uint64_t>(DS::Hash<T>{}(key)));
+        }
+
+        /**
+         * @brief Estimates the number of distinct keys added so far.
+         * @return The estimated cardinality.
+         */
+        double estimate() const {
+            const std::size_t m = register_count();
+            const int q = 64 - precision;
+            std::vector<std::size_t> histogram(static_cast<std::size_t>(q) + 2, 0);
+
+            if (is_sparse()) {
+                const std::vector<std::uint32_t> entries = sparse_entries();
+                histogram[0] = m - entries.size();
+                for (const std::uint32_t entry: entries) ++histogram[entry & 0xff];
+            } else {
+                for (const std::uint8_t value: registers) ++histogram[value];
+            }
+
+            const double md = static_cast<double>(m);
+            double z = md * tau(1.0 - static_cast<double>(histogram[q + 1]) / md);
+            for (int k = q; k >= 1; --k) {
+                z = 0.5 * (z + static_cast<double>(histogram[k]));
+            }
+            z += md * sigma(static_cast<double>(histogram[0]) / md);
+
+            return md * md / (2.0 * std::log(2.0) * z);
+        }
+
+        /**
+         * @brief Adds every key counted by another sketch to this one.
+         * @param other A sketch with the same precision.
+         * @throws std::runtime_error If the precisions differ.
+         */
+        void merge(const HyperLogLog &other) {
+            if (other.precision != precision) {
+                throw std::runtime_error("Cannot merge HyperLogLog sketches of different precision");
+            }
+
+            if (other.is_sparse()) {
+                for (const std::uint32_t entry: other.sparse) set_register(entry >> 8, entry & 0xff);
+                for (const std::uint32_t entry: other.buffer) set_register(entry >> 8, entry & 0xff);
+                return;
+            }
+
+            if (is_sparse()) to_dense();
+
+            std::uint8_t *target = registers.data();
+            const std::uint8_t *source = other.registers.data();
+            std::size_t i = 0;
+#if defined(__SSE2__)
+            for (; i + 16 <= registers.size(); i += 16) {
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(target + i));
+                const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(target + i), _mm_max_epu8(a, b));
+            }
+#endif
+            for (; i < registers.size(); ++i) {
+                target[i] = std::max(target[i], source[i]);
+            }
+        }
+
+        /**
+         * @brief Forgets every key and returns to the sparse representation.
+         */
+        void clear() {
+            registers.clear();
+            registers.shrink_to_fit();
+            sparse.clear();
+            buffer.clear();
+        }
+
+        /**
+         * @brief Returns the precision the sketch was built with.
+         */
+        std::uint8_t get_precision() const noexcept {
+            return precision;
+        }
+
+        /**
+         * @brief Checks whether the sketch still uses the sparse representation.
+         */
+        bool sparse_mode() const noexcept {
+            return is_sparse();
+        }
+
+        /**
+         * @brief Serializes the sketch to a portable byte string.
+         *
+         * Layout: "DSHL", u32 format version, u8 precision, u8 mode (0 sparse, 1 dense), then
+         * either a u32 entry count followed by u32 little-endian entries, or the raw registers.
+         *
+         * @return The serialized sketch.
+         */
+        std::vector<std::uint8_t> serialize() const {
+            std::vector<std::uint8_t> out;
+            for (const char c: magic) out.push_back(static_cast<std::uint8_t>(c));
+            write_u32(out, format_version);
+            out.push_back(precision);
+            out.push_back(is_sparse() ? 0 : 1);
+
+            if (is_sparse()) {
+                const std::vector<std::uint32_t> entries = sparse_entries();
+                write_u32(out, static_cast<std::uint32_t>(entries.size()));
+                for (const std::uint32_t entry: entries) write_u32(out, entry);
+            } else {
+                out.insert(out.end(), registers.begin(), registers.end());
+            }
+
+            return out;
+        }
+
+        /**
+         * @brief Rebuilds a sketch from the output of serialize().
+         * @param bytes The serialized sketch.
+         * @return The sketch.
+         * @throws std::runtime_error If the bytes are not a valid serialized sketch.
+         */
+        static HyperLogLog deserialize(const std::vector<std::uint8_t> &bytes) {
+            if (bytes.size() < 10 || std::memcmp(bytes.data(), magic, 4) != 0) {
+                throw std::runtime_error("Invalid HyperLogLog data");
+            }
+            if (read_u32(bytes.data() + 4) != format_version) {
+                throw std::runtime_error("Unsupported HyperLogLog version");
+            }
+
+            HyperLogLog sketch(bytes[8]);
+            const std::uint8_t *in = bytes.data() + 10;
+            const std::size_t remaining = bytes.size() - 10;
+            // estimate() indexes its histogram by rank, so a larger rank must not get in.
+            const unsigned max_rank = 64U - sketch.precision + 1U;
+
+            if (bytes[9] == 0) {
+                if (remaining < 4) throw std::runtime_error("Invalid HyperLogLog data");
+                const std::uint32_t count = read_u32(in);
+                if (remaining != 4 + static_cast<std::size_t>(count) * 4) {
+                    throw std::runtime_error("Invalid HyperLogLog data");
+                }
+                for (std::uint32_t i = 0; i < count; ++i) {
+                    const std::uint32_t entry = read_u32(in + 4 + i * 4);
+                    if ((entry >> 8) >= sketch.register_count() || (entry & 0xff) > max_rank) {
+                        throw std::runtime_error("Invalid HyperLogLog data");
+                    }
+                    sketch.set_register(entry >> 8, entry & 0xff);
+                }
+            } else if (bytes[9] == 1) {
+                if (remaining != sketch.register_count() ||
+                    std::any_of(in, in + remaining, [max_rank](const std::uint8_t rank) { return rank > max_rank; })) {
+                    throw std::runtime_error("Invalid HyperLogLog data");
+                }
+                sketch.registers.assign(in, in + remaining);
+            } else {
+                throw std::runtime_error("Invalid HyperLogLog data");
+            }
+
+            return sketch;
+        }
+    };
+} // DS
+
+#endif //HYPERLOGLOG_H
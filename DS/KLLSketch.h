@@ -0,0 +1,323 @@
+#ifndef KLLSKETCH_H
+#define KLLSKETCH_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace DS {
+    /**
+     * @brief A KLL sketch for approximate ranks and quantiles of a stream.
+     *
+     * The sketch keeps a stack of compactors. Level h holds items that each stand for 2^h
+     * stream items. When the sketch outgrows its total capacity, the lowest full level is
+     * sorted and every other item, starting at a random offset, is promoted to the level
+     * above; the rest are dropped. Capacities shrink
+     * geometrically by 2/3 from the top level (k items) down to at least 8, so memory stays
+     * O(k) no matter how many items are added.
+     *
+     * Rank error: with probability 99%, rank() and quantile() are off by at most
+     * normalized_rank_error() * count() positions, about 1.33% at the default k = 200 and
+     * 0.25% at k = 1200. min() and max() are exact.
+     *
+     * Sketches built with the same k can be merged, so each thread can feed its own sketch
+     * without synchronization and merge the results in any order.
+     *
+     * @tparam T The type of the items. Must be ordered by operator<.
+     */
+    template<typename T = double>
+    class KLLSketch {
+        static constexpr std::size_t min_capacity = 8;
+
+        std::size_t k;
+        std::vector<std::vector<T> > levels; ///< levels[h] holds items of weight 2^h.
+        std::uint64_t n;
+        std::size_t stored; ///< Number of retained items over all levels.
+        std::size_t limit; ///< Sum of the level capacities; recomputed when a level is added.
+        T min_value;
+        T max_value;
+        std::uint64_t random_state;
+
+        std::size_t capacity(const std::size_t level) const {
+            const std::size_t depth = levels.size() - 1 - level;
+            const auto cap = static_cast<std::size_t>(std::ceil(static_cast<double>(k) * std::pow(2.0 / 3.0, depth)));
+            return cap < min_capacity ? min_capacity : cap;
+        }
+
+        void update_limit() {
+            limit = 0;
+            for (std::size_t level = 0; level < levels.size(); ++level) limit += capacity(level);
+        }
+
+        bool random_bit() {
+            // xorshift64: cheap, and good enough to pick the compaction offset.
+            random_state ^= random_state << 13;
+            random_state ^= random_state >> 7;
+            random_state ^= random_state << 17;
+            return random_state & 1;
+        }
+
+        void compact(const std::size_t level) {
+            if (level + 1 == levels.size()) {
+                levels.emplace_back();
+                update_limit();
+            }
+
+            std::vector<T> &items = levels[level];
+            std::sort(items.begin(), items.end());
+
+            // An odd item stays behind so that the total weight is preserved exactly.
+            const std::size_t usable = items.size() & ~std::size_t{1};
+            std::vector<T> &above = levels[level + 1];
+            for (std::size_t i = random_bit() ? 1 : 0; i < usable; i += 2) {
+                above.push_back(items[i]);
+            }
+            stored -= usable / 2;
+
+            if (items.size() > usable) {
+                items[0] = std::move(items.back());
+                items.resize(1);
+            } else {
+                items.clear();
+            }
+        }
+
+        /**
+         * @brief Compacts the lowest full level until the sketch fits its total capacity again.
+         *
+         * Waiting for the total capacity rather than compacting every full level keeps more
+         * items in the lower levels, which lowers the error for the same memory.
+         */
+        void compress() {
+            while (stored >= limit) {
+                for (std::size_t level = 0; level < levels.size(); ++level) {
+                    if (levels[level].size() >= capacity(level)) {
+                        compact(level);
+                        break;
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Collects every retained item with its weight, sorted by item.
+         */
+        std::vector<std::pair<T, std::uint64_t> > weighted_items() const {
+            std::vector<std::pair<T, std::uint64_t> > items;
+            for (std::size_t level = 0; level < levels.size(); ++level) {
+                for (const T &item: levels[level]) items.emplace_back(item, std::uint64_t{1} << level);
+            }
+            std::sort(items.begin(), items.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+            return items;
+        }
+
+        static T quantile_of(const std::vector<std::pair<T, std::uint64_t> > &items, const std::uint64_t total,
+                             const double fraction) {
+            const double target = fraction * static_cast<double>(total);
+            std::uint64_t cumulative = 0;
+
+            for (const auto &[item, weight]: items) {
+                cumulative += weight;
+                if (static_cast<double>(cumulative) >= target) return item;
+            }
+            return items.back().first;
+        }
+
+    public:
+        /**
+         * @brief Constructs an empty sketch.
+         *
+         * @param k The size of the top compactor; larger k means more memory and less error.
+         * @param seed Seed of the random compaction offsets.
+         * @throws std::runtime_error If k is smaller than 8.
+         */
+        explicit KLLSketch(const std::size_t k = 200, const std::uint64_t seed = 0x9e3779b97f4a7c15ULL)
+            : k(k), levels(1), n(0), stored(0), limit(0), min_value(), max_value(),
+              random_state(seed == 0 ? 1 : seed) {
+            if (k < min_capacity) throw std::runtime_error("Invalid KLL sketch size");
+            update_limit();
+        }
+
+        /**
+         * @brief Returns the normalized rank error at 99% confidence for a given k.
+         *
+         * This is the empirical fit published with the Apache DataSketches KLL sketch.
+         *
+         * @param k The sketch size.
+         * @return The error as a fraction of count().
+         */
+        static double normalized_rank_error(const std::size_t k) {
+            return 2.296 / std::pow(static_cast<double>(k), 0.9723);
+        }
+
+        /**
+         * @brief Returns the normalized rank error at 99% confidence of this sketch.
+         */
+        double normalized_rank_error() const {
+            return normalized_rank_error(k);
+        }
+
+        /**
+         * @brief Adds one item to the sketch.
+         * @param value The item to add.
+         */
+        void add(const T &value) {
+            if (n == 0 || value < min_value) min_value = value;
+            if (n == 0 || max_value < value) max_value = value;
+            ++n;
+
+            levels[0].push_back(value);
+            if (++stored >= limit) compress();
+        }
+
+        /**
+         * @brief Adds a batch of items to the sketch.
+         * @param values Pointer to the first item.
+         * @param count The number of items.
+         */
+        void add(const T *values, const std::size_t count) {
+            for (std::size_t i = 0; i < count; ++i) add(values[i]);
+        }
+
+        /**
+         * @brief Adds every item of an iterator range to the sketch.
+         * @param begin Iterator to the first item.
+         * @param end Iterator past the last item.
+         */
+        template<typename It>
+        void add(It begin, It end) {
+            for (; begin != end; ++begin) add(*begin);
+        }
+
+        /**
+         * @brief Adds every item summarized by another sketch to this one.
+         * @param other A sketch built with the same k.
+         * @throws std::runtime_error If the sketches were built with different k.
+         */
+        void merge(const KLLSketch &other) {
+            if (other.k != k) throw std::runtime_error("Cannot merge KLL sketches of different sizes");
+            if (other.n == 0) return;
+
+            if (n == 0 || other.min_value < min_value) min_value = other.min_value;
+            if (n == 0 || max_value < other.max_value) max_value = other.max_value;
+            n += other.n;
+
+            if (levels.size() < other.levels.size()) {
+                levels.resize(other.levels.size());
+                update_limit();
+            }
+            for (std::size_t level = 0; level < other.levels.size(); ++level) {
+                levels[level].insert(levels[level].end(), other.levels[level].begin(), other.levels[level].end());
+            }
+            stored += other.stored;
+
+            compress();
+        }
+
+        /**
+         * @brief Returns the number of items added, including merged sketches.
+         */
+        std::uint64_t count() const noexcept {
+            return n;
+        }
+
+        bool empty() const noexcept {
+            return n == 0;
+        }
+
+        /**
+         * @brief Returns the number of items retained by the sketch.
+         */
+        std::size_t retained() const noexcept {
+            return stored;
+        }
+
+        /**
+         * @brief Returns the smallest item added.
+         * @throws std::runtime_error If the sketch is empty.
+         */
+        T min() const {
+            if (n == 0) throw std::runtime_error("KLL sketch is empty");
+            return min_value;
+        }
+
+        /**
+         * @brief Returns the largest item added.
+         * @throws std::runtime_error If the sketch is empty.
+         */
+        T max() const {
+            if (n == 0) throw std::runtime_error("KLL sketch is empty");
+            return max_value;
+        }
+
+        /**
+         * @brief Estimates the fraction of items that are less than or equal to a value.
+         * @param value The value to rank.
+         * @return The normalized rank, between 0 and 1.
+         * @throws std::runtime_error If the sketch is empty.
+         */
+        double rank(const T &value) const {
+            if (n == 0) throw std::runtime_error("KLL sketch is empty");
+
+            std::uint64_t weight = 0;
+            for (std::size_t level = 0; level < levels.size(); ++level) {
+                for (const T &item: levels[level]) {
+                    if (!(value < item)) weight += std::uint64_t{1} << level;
+                }
+            }
+            return static_cast<double>(weight) / static_cast<double>(n);
+        }
+
+        /**
+         * @brief Estimates the item at a normalized rank, e.g. 0.5 for the median or 0.99 for p99.
+         * @param fraction The rank, between 0 and 1.
+         * @return The estimated quantile; quantile(0) is min() and quantile(1) is max().
+         * @throws std::runtime_error If the sketch is empty or the fraction is out of range.
+         */
+        T quantile(const double fraction) const {
+            if (n == 0) throw std::runtime_error("KLL sketch is empty");
+            if (!(fraction >= 0.0 && fraction <= 1.0)) throw std::runtime_error("Invalid quantile");
+            if (fraction == 0.0) return min_value;
+            if (fraction == 1.0) return max_value;
+            return quantile_of(weighted_items(), n, fraction);
+        }
+
+        /**
+         * @brief Estimates several quantiles at once, sorting the retained items only once.
+         * @param fractions The ranks, each between 0 and 1.
+         * @return The estimated quantiles, in the order of the fractions.
+         * @throws std::runtime_error If the sketch is empty or a fraction is out of range.
+         */
+        std::vector<T> quantiles(const std::vector<double> &fractions) const {
+            if (n == 0) throw std::runtime_error("KLL sketch is empty");
+
+            const auto items = weighted_items();
+            std::vector<T> result;
+            result.reserve(fractions.size());
+
+            for (const double fraction: fractions) {
+                if (!(fraction >= 0.0 && fraction <= 1.0)) throw std::runtime_error("Invalid quantile");
+                if (fraction == 0.0) result.push_back(min_value);
+                else if (fraction == 1.0) result.push_back(max_value);
+                else result.push_back(quantile_of(items, n, fraction));
+            }
+            return result;
+        }
+
+        /**
+         * @brief Forgets every item.
+         */
+        void clear() {
+            levels.assign(1, std::vector<T>());
+            n = 0;
+            stored = 0;
+            update_limit();
+        }
+    };
+} // DS
+
+#endif //KLLSKETCH_H
@@ -0,0 +1,389 @@
+#ifndef KEYSORT_H
+#define KEYSORT_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Array.h"
+
+namespace DS {
+    enum class SortOrder { ascending, descending };
+
+    /**
+     * @brief A sort key encoded as bytes whose memcmp order is the order of the fields it was built from.
+     *
+     * Fields are appended most significant first. Integers are stored big-endian with the
+     * sign bit flipped, floating-point numbers with the sign bit flipped for positive values
+     * and every bit flipped for negative ones, and strings with their zero bytes escaped and
+     * a two-byte terminator, so that a string sorts before its extensions. A descending
+     * field is stored with every byte inverted.
+     *
+     * Every encoding is prefix-free, so comparing two keys byte by byte compares their
+     * fields one after the other, as a multi-field comparator would.
+     */
+    class SortKey {
+        std::vector<std::uint8_t> bytes;
+
+        template<typename U>
+        void append_big_endian(U bits, const SortOrder order) {
+            if (order == SortOrder::descending) bits = static_cast<U>(~bits);
+            const std::size_t offset = bytes.size();
+            bytes.resize(offset + sizeof(U));
+            for (std::size_t i = 0; i < sizeof(U); ++i) {
+                bytes[offset + i] = static_cast<std::uint8_t>(bits >> (8 * (sizeof(U) - 1 - i)));
+            }
+        }
+
+    public:
+        /**
+         * @brief Appends an arithmetic field.
+         *
+         * -0.0 is stored as 0.0, and every NaN, whatever its sign and payload, is stored as
+         * the same positive quiet NaN, which sorts after every other value in ascending order.
+         *
+         * @param value The field.
+         * @param order The order of the field.
+         */
+        template<typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+        void add(const U value, const SortOrder order = SortOrder::ascending) {
+            if constexpr (std::is_same<U, bool>::value) {
+                append_big_endian(static_cast<std::uint8_t>(value), order);
+            } else if constexpr (std::is_integral<U>::value) {
+                using Bits = std::make_unsigned_t<U>;
+                auto bits = static_cast<Bits>(value);
+                if constexpr (std::is_signed<U>::value) {
+                    bits ^= static_cast<Bits>(Bits(1) << (8 * sizeof(U) - 1));
+                }
+                append_big_endian(bits, order);
+            } else {
+                static_assert(sizeof(U) == 4 || sizeof(U) == 8, "SortKey supports float and double only");
+                using Bits = std::conditional_t<sizeof(U) == 4, std::uint32_t, std::uint64_t>;
+                constexpr Bits sign = Bits(1) << (8 * sizeof(U) - 1);
+                const bool nan = value != value;
+                const U normalized = nan ? std::numeric_limits<U>::quiet_NaN() : value == U(0) ? U(0) : value;
+                Bits bits;
+                std::memcpy(&bits, &normalized, sizeof(U));
+                // A NaN computed at run time usually has its sign bit set, which would sort it first.
+                if (nan) bits &= static_cast<Bits>(~sign);
+                bits = (bits & sign) ? static_cast<Bits>(~bits) : static_cast<Bits>(bits | sign);
+                append_big_endian(bits, order);
+            }
+        }
+
+        /**
+         * @brief Appends a string field, compared byte by byte as unsigned characters.
+         * @param value The field.
+         * @param order The order of the field.
+         */
+        void add(const std::string_view value, const SortOrder order = SortOrder::ascending) {
+            const std::uint8_t flip = order == SortOrder::descending ? 0xFF : 0x00;
+            for (const char c: value) {
+                const auto byte = static_cast<std::uint8_t>(c);
+                bytes.push_back(byte ^ flip);
+                if (byte == 0) bytes.push_back(0xFF ^ flip);
+            }
+            bytes.push_back(flip);
+            bytes.push_back(flip);
+        }
+
+        void add(const char *value, const SortOrder order = SortOrder::ascending) {
+            add(std::string_view(value), order);
+        }
+
+        /**
+         * @brief Appends the first width bytes of a string, padded with zero bytes.
+         *
+         * Shorter than add() for long strings, but strings that agree on their first
+         * width bytes compare equal on this field.
+         *
+         * @param value The field.
+         * @param width The number of bytes stored.
+         * @param order The order of the field.
+         */
+        void add_prefix(const std::string_view value, const std::size_t width,
+                        const SortOrder order = SortOrder::ascending) {
+            const std::uint8_t flip = order == SortOrder::descending ? 0xFF : 0x00;
+            const std::size_t stored = std::min(width, value.size());
+            for (std::size_t i = 0; i < stored; ++i) bytes.push_back(static_cast<std::uint8_t>(value[i]) ^ flip);
+            bytes.insert(bytes.end(), width - stored, flip);
+        }
+
+        void clear() noexcept {
+            bytes.clear();
+        }
+
+        const std::uint8_t *data() const noexcept {
+            return bytes.data();
+        }
+
+        std::size_t size() const noexcept {
+            return bytes.size();
+        }
+
+        /**
+         * @brief Compares two encoded keys.
+         * @return A negative number, zero or a positive number if a sorts before, with or after b.
+         */
+        static int compare(const std::uint8_t *a, const std::size_t a_size,
+                           const std::uint8_t *b, const std::size_t b_size) noexcept {
+            const std::size_t common = std::min(a_size, b_size);
+            const int result = common == 0 ? 0 : std::memcmp(a, b, common);
+            if (result != 0) return result;
+            return a_size < b_size ? -1 : a_size > b_size ? 1 : 0;
+        }
+
+        bool operator<(const SortKey &other) const noexcept {
+            return compare(data(), size(), other.data(), other.size()) < 0;
+        }
+
+        bool operator==(const SortKey &other) const noexcept {
+            return bytes == other.bytes;
+        }
+
+        friend class KeySort;
+    };
+
+    /**
+     * @brief Stable multi-field sort that encodes each record's key once instead of comparing fields on every comparison.
+     *
+     * A comparator-based sort of records by several fields evaluates the fields of both
+     * records O(n log n) times and branches on each of them. Here the key function runs
+     * once per record and fills a SortKey. The first 8 bytes of every key are cached,
+     * big-endian, next to the record's index, and these (prefix, index) pairs are sorted
+     * by a radix sort over the bits in which the prefixes differ.
+     * Only runs of records whose prefixes tie are then sorted by comparing the full keys,
+     * and only if some keys are longer than 8 bytes or the keys differ in size, since a
+     * shorter key sorts before a longer one with the same zero-padded prefix. Finally the records are gathered, in
+     * sorted order, into a buffer that is moved back over them.
+     *
+     * permute() instead moves the records in place by following the cycles of the
+     * permutation, without the buffer. Each step of a cycle depends on the cache miss of
+     * the one before, while the loads of a gather are independent and overlap, so
+     * permute() is several times slower on arrays that do not fit in the cache.
+     *
+     * Keys that all have the same size of at most 8 bytes, such as two 32-bit integers
+     * or a double, need no comparison at all.
+     */
+    class KeySort {
+        static constexpr std::size_t prefix_bytes = 8;
+        static constexpr std::size_t radix_threshold = 256; ///< Below this size the pairs are sorted by comparison.
+        static constexpr unsigned max_digit_bits = 11;
+        static constexpr std::size_t cache_entries = std::size_t(1) << 15; ///< Pairs that fit in a typical L2 cache.
+
+        struct Entry {
+            std::uint64_t prefix;
+            std::uint32_t index;
+        };
+
+        static std::uint64_t load_prefix(const std::uint8_t *key, const std::size_t size) noexcept {
+            std::uint64_t prefix = 0;
+            const std::size_t stored = std::min(size, prefix_bytes);
+            for (std::size_t i = 0; i < stored; ++i) prefix |= std::uint64_t(key[i]) << (56 - 8 * i);
+            return prefix;
+        }
+
+        /**
+         * @brief Stable radix sort of the pairs by prefix.
+         *
+         * Only the bits in which some prefixes differ are sorted, in digits of at most
+         * max_digit_bits so that the histograms stay in L1. A range of more than
+         * cache_entries pairs is first split on its top digit, and each part is then
+         * sorted while it stays in the cache, instead of every digit taking a pass over
+         * all of memory.
+         *
+         * @param entries The pairs to sort.
+         * @param buffer Scratch space for as many pairs.
+         * @param n The number of pairs.
+         */
+        static void radix_sort(Entry *entries, Entry *buffer, const std::size_t n) {
+            if (n < 2) return;
+
+            std::uint64_t varying = 0;
+            for (std::size_t i = 1; i < n; ++i) varying |= entries[i].prefix ^ entries[0].prefix;
+            if (varying == 0) return;
+
+            const auto low = static_cast<unsigned>(__builtin_ctzll(varying));
+            const unsigned bits = 64 - static_cast<unsigned>(__builtin_clzll(varying)) - low;
+
+            if (bits > max_digit_bits && n > cache_entries) {
+                const unsigned shift = low + bits - max_digit_bits;
+                constexpr std::uint64_t mask = (std::uint64_t(1) << max_digit_bits) - 1;
+                std::vector<std::size_t> starts(mask + 2, 0);
+                for (std::size_t i = 0; i < n; ++i) ++starts[((entries[i].prefix >> shift) & mask) + 1];
+                for (std::size_t bucket = 1; bucket < starts.size(); ++bucket) starts[bucket] += starts[bucket - 1];
+
+                std::vector<std::size_t> next(starts.begin(), starts.end() - 1);
+                for (std::size_t i = 0; i < n; ++i) buffer[next[(entries[i].prefix >> shift) & mask]++] = entries[i];
+                std::copy(buffer, buffer + n, entries);
+
+                for (std::size_t bucket = 0; bucket + 1 < starts.size(); ++bucket) {
+                    radix_sort(entries + starts[bucket], buffer + starts[bucket], starts[bucket + 1] - starts[bucket]);
+                }
+                return;
+            }
+
+            const unsigned passes = (bits + max_digit_bits - 1) / max_digit_bits;
+            const unsigned digit_bits = (bits + passes - 1) / passes;
+            const std::size_t buckets = std::size_t(1) << digit_bits;
+            const std::uint64_t mask = buckets - 1;
+
+            std::vector<std::size_t> counts(passes * buckets, 0);
+            for (std::size_t i = 0; i < n; ++i) {
+                const std::uint64_t prefix = entries[i].prefix >> low;
+                for (unsigned pass = 0; pass < passes; ++pass) {
+                    ++counts[pass * buckets + ((prefix >> (pass * digit_bits)) & mask)];
+                }
+            }
+
+            Entry *from = entries;
+            Entry *to = buffer;
+            for (unsigned pass = 0; pass < passes; ++pass) {
+                std::size_t *count = counts.data() + pass * buckets;
+                const unsigned shift = low + pass * digit_bits;
+                std::size_t offset = 0;
+                for (std::size_t bucket = 0; bucket < buckets; ++bucket) {
+                    const std::size_t bucket_size = count[bucket];
+                    count[bucket] = offset;
+                    offset += bucket_size;
+                }
+                for (std::size_t i = 0; i < n; ++i) to[count[(from[i].prefix >> shift) & mask]++] = from[i];
+                std::swap(from, to);
+            }
+            if (from != entries) std::copy(from, from + n, entries);
+        }
+
+        /**
+         * @brief Sorts (prefix, index) pairs by full key, ties broken by index.
+         */
+        static void sort_entries(std::vector<Entry> &entries, const SortKey &keys,
+                                 const std::vector<std::size_t> &offsets, const bool compare_ties) {
+            const auto full_less = [&keys, &offsets](const Entry &a, const Entry &b) {
+                if (a.prefix != b.prefix) return a.prefix < b.prefix;
+                const int result = SortKey::compare(
+                    keys.data() + offsets[a.index], offsets[a.index + 1] - offsets[a.index],
+                    keys.data() + offsets[b.index], offsets[b.index + 1] - offsets[b.index]);
+                return result != 0 ? result < 0 : a.index < b.index;
+            };
+
+            if (entries.size() < radix_threshold) {
+                std::sort(entries.begin(), entries.end(), full_less);
+                return;
+            }
+
+            std::vector<Entry> buffer(entries.size());
+            radix_sort(entries.data(), buffer.data(), entries.size());
+            if (!compare_ties) return;
+
+            // Ties on the prefix are in index order, which is only right for equal keys.
+            for (std::size_t begin = 0; begin < entries.size();) {
+                std::size_t end = begin + 1;
+                while (end < entries.size() && entries[end].prefix == entries[begin].prefix) ++end;
+                if (end - begin > 1) std::sort(entries.begin() + begin, entries.begin() + end, full_less);
+                begin = end;
+            }
+        }
+
+    public:
+        /**
+         * @brief Computes the order in which the records should appear, without moving them.
+         * @param first The first record.
+         * @param count The number of records.
+         * @param key A function called as key(record, sort_key) once per record, which adds the record's fields to sort_key.
+         * @return order[i] is the index of the record that belongs at position i.
+         * @throws std::runtime_error If there are more than 2^32 - 1 records.
+         */
+        template<typename T, typename KeyFn>
+        static std::vector<std::uint32_t> order(const T *first, const std::size_t count, KeyFn key) {
+            if (count >= std::numeric_limits<std::uint32_t>::max()) {
+                throw std::runtime_error("Too many records for KeySort");
+            }
+
+            SortKey keys;
+            std::vector<std::size_t> offsets(count + 1);
+            std::vector<Entry> entries(count);
+            bool compare_ties = false;
+            offsets[0] = 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                key(first[i], keys);
+                offsets[i + 1] = keys.size();
+                // Records usually have keys of similar sizes.
+                if (i == 0) keys.bytes.reserve(keys.size() * count);
+                const std::size_t size = offsets[i + 1] - offsets[i];
+                entries[i] = {load_prefix(keys.data() + offsets[i], size), static_cast<std::uint32_t>(i)};
+                // A key padded with zeros ties with a longer key whose extra bytes are zero.
+                compare_ties |= size > prefix_bytes || size != offsets[1];
+            }
+
+            sort_entries(entries, keys, offsets, compare_ties);
+
+            std::vector<std::uint32_t> result(count);
+            for (std::size_t i = 0; i < count; ++i) result[i] = entries[i].index;
+            return result;
+        }
+
+        /**
+         * @brief Moves the records so that the record at order[i] ends up at position i.
+         *
+         * Each cycle of the permutation is followed once, with one record held aside.
+         *
+         * @param first The first record.
+         * @param order A permutation of 0..order.size() - 1; reset to the identity on return.
+         */
+        template<typename T>
+        static void permute(T *first, std::vector<std::uint32_t> &order) {
+            for (std::size_t start = 0; start < order.size(); ++start) {
+                if (order[start] == start) continue;
+
+                T held = std::move(first[start]);
+                std::size_t hole = start;
+                for (;;) {
+                    const std::size_t source = order[hole];
+                    order[hole] = static_cast<std::uint32_t>(hole);
+                    if (source == start) break;
+                    first[hole] = std::move(first[source]);
+                    hole = source;
+                }
+                first[hole] = std::move(held);
+            }
+        }
+
+        /**
+         * @brief Moves the records so that the record at order[i] ends up at position i, through a buffer of order.size() records.
+         */
+        template<typename T>
+        static void gather(T *first, const std::vector<std::uint32_t> &order) {
+            std::vector<T> sorted;
+            sorted.reserve(order.size());
+            for (const std::uint32_t index: order) sorted.push_back(std::move(first[index]));
+            std::move(sorted.begin(), sorted.end(), first);
+        }
+
+        /**
+         * @brief Sorts records by the keys a key function builds for them. Records with equal keys keep their order.
+         * @param first The first record.
+         * @param count The number of records.
+         * @param key A function called as key(record, sort_key) once per record, which adds the record's fields to sort_key.
+         * @throws std::runtime_error If there are more than 2^32 - 1 records.
+         */
+        template<typename T, typename KeyFn>
+        static void sort(T *first, const std::size_t count, KeyFn key) {
+            if (count < 2) return;
+            gather(first, order(static_cast<const T *>(first), count, key));
+        }
+
+        template<typename T, typename KeyFn>
+        static void sort(Array<T> &array, KeyFn key) {
+            sort(array.begin(), static_cast<std::size_t>(array.size()), key);
+        }
+    };
+} // DS
+
+#endif //KEYSORT_H
@@ -0,0 +1,483 @@
+#ifndef MATRIX_H
+#define MATRIX_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#endif
+
+namespace DS {
+    /**
+     * @brief The order in which the elements of a Matrix are stored.
+     */
+    enum class Layout {
+        RowMajor, ///< Each row is contiguous.
+        ColumnMajor ///< Each column is contiguous.
+    };
+
+    /**
+     * @brief A strided view of a row or a column of a Matrix.
+     *
+     * @tparam T The type of the elements; const for read-only views.
+     */
+    template<typename T>
+    class VectorView {
+        T *first;
+        std::size_t count;
+        std::size_t step;
+
+    public:
+        VectorView(T *first, const std::size_t count, const std::size_t step) : first(first), count(count), step(step) {}
+
+        std::size_t size() const noexcept {
+            return count;
+        }
+
+        /**
+         * @brief Returns the distance, in elements, between two consecutive elements; 1 if contiguous.
+         */
+        std::size_t stride() const noexcept {
+            return step;
+        }
+
+        T &operator[](const std::size_t index) const {
+            return first[index * step];
+        }
+
+        /**
+         * @throws std::out_of_range If the index is out of bounds.
+         */
+        T &at(const std::size_t index) const {
+            if (index >= count) throw std::out_of_range("Index out of bounds");
+            return first[index * step];
+        }
+    };
+
+    /**
+     * @brief A dense 2-D matrix of numbers in one contiguous, cache-line aligned allocation.
+     *
+     * Elements are stored row-major or column-major. Every row (or column) starts on a
+     * cache line: the leading dimension, the distance between the starts of two rows (or
+     * columns), is rounded up to a multiple of 64 bytes and the padding holds zeros.
+     *
+     * transpose() and multiply() work on cache-sized tiles. multiply() accumulates into
+     * each tile of the result from panels of the operands that stay in cache. For float
+     * with AVX2 and FMA, the panels are first packed into contiguous, zero-padded strips
+     * that a 6 x 16 register-blocked kernel streams through.
+     *
+     * @tparam T The type of the elements. Must be an arithmetic type.
+     */
+    template<typename T>
+    class Matrix {
+        static_assert(std::is_arithmetic<T>::value, "Matrix requires an arithmetic type");
+
+        static constexpr std::size_t alignment = 64;
+        static constexpr std::size_t lanes = alignment / sizeof(T) > 0 ? alignment / sizeof(T) : 1;
+        static constexpr std::size_t transpose_tile = 32;
+        static constexpr std::size_t row_block = 96; ///< Rows of A and C per tile of multiply().
+        static constexpr std::size_t depth_block = 256; ///< Columns of A and rows of B per panel.
+        static constexpr std::size_t column_block = 1024; ///< Columns of B and C per tile.
+
+        std::size_t n_rows;
+        std::size_t n_cols;
+        Layout order;
+        std::size_t ld;
+        T *values;
+
+        static T *allocate(const std::size_t count) {
+            if (count == 0) return nullptr;
+            auto *memory = static_cast<T *>(::operator new(count * sizeof(T), std::align_val_t(alignment)));
+            std::memset(memory, 0, count * sizeof(T));
+            return memory;
+        }
+
+        static void release(T *memory) {
+            if (memory != nullptr) ::operator delete(memory, std::align_val_t(alignment));
+        }
+
+        std::size_t storage_size() const noexcept {
+            return ld * (order == Layout::RowMajor ? n_rows : n_cols);
+        }
+
+        std::size_t offset(const std::size_t row, const std::size_t col) const noexcept {
+            return order == Layout::RowMajor ? row * ld + col : col * ld + row;
+        }
+
+        /**
+         * @brief Copies outer x inner elements into the transposed position, tile by tile so both sides stay in cache.
+         */
+        static void transpose_tiles(const T *source, const std::size_t source_ld, T *target, const std::size_t target_ld,
+                                    const std::size_t outer, const std::size_t inner) {
+            for (std::size_t ob = 0; ob < outer; ob += transpose_tile) {
+                for (std::size_t ib = 0; ib < inner; ib += transpose_tile) {
+                    const std::size_t o_end = std::min(outer, ob + transpose_tile);
+                    const std::size_t i_end = std::min(inner, ib + transpose_tile);
+                    for (std::size_t o = ob; o < o_end; ++o) {
+                        for (std::size_t i = ib; i < i_end; ++i) target[i * target_ld + o] = source[o * source_ld + i];
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Adds A[rows, depth] * B[depth, cols] to C for one tile; all three are row-major.
+         */
+        static void multiply_tile(const T *a, const std::size_t lda, const T *b, const std::size_t ldb, T *c,
+                                  const std::size_t ldc, const std::size_t rows, const std::size_t depth,
+                                  const std::size_t cols) {
+            // A row of C accumulates scaled rows of B, a loop compilers vectorize.
+            for (std::size_t i = 0; i < rows; ++i) {
+                T *c_row = c + i * ldc;
+                for (std::size_t k = 0; k < depth; ++k) {
+                    const T scalar = a[i * lda + k];
+                    const T *b_row = b + k * ldb;
+                    for (std::size_t j = 0; j < cols; ++j) c_row[j] += scalar * b_row[j];
+                }
+            }
+        }
+
+#if defined(__AVX2__) && defined(__FMA__)
+        static constexpr std::size_t kernel_rows = 6;
+        static constexpr std::size_t kernel_cols = 16;
+
+        /**
+         * @brief Adds the product of a packed 6-row panel of A and a packed 16-column strip of B to C.
+         *
+         * The 6 x 16 block of C stays in 12 registers while both panels are streamed from
+         * contiguous memory: every step loads 2 vectors of B and broadcasts 6 values of A.
+         */
+        static void kernel(const float *a, const float *b, const std::size_t depth, float *c, const std::size_t ldc,
+                           const std::size_t rows, const std::size_t cols) {
+            // Spelled out rather than looped so that the accumulators stay in registers at any optimization level.
+            __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps(), c10 = _mm256_setzero_ps();
+            __m256 c11 = _mm256_setzero_ps(), c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+            __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps(), c40 = _mm256_setzero_ps();
+            __m256 c41 = _mm256_setzero_ps(), c50 = _mm256_setzero_ps(), c51 = _mm256_setzero_ps();
+
+            for (std::size_t k = 0; k < depth; ++k, a += kernel_rows, b += kernel_cols) {
+                const __m256 b0 = _mm256_load_ps(b);
+                const __m256 b1 = _mm256_load_ps(b + 8);
+                __m256 scalar = _mm256_broadcast_ss(a);
+                c00 = _mm256_fmadd_ps(scalar, b0, c00);
+                c01 = _mm256_fmadd_ps(scalar, b1, c01);
+                scalar = _mm256_broadcast_ss(a + 1);
+                c10 = _mm256_fmadd_ps(scalar, b0, c10);
+                c11 = _mm256_fmadd_ps(scalar, b1, c11);
+                scalar = _mm256_broadcast_ss(a + 2);
+                c20 = _mm256_fmadd_ps(scalar, b0, c20);
+                c21 = _mm256_fmadd_ps(scalar, b1, c21);
+                scalar = _mm256_broadcast_ss(a + 3);
+                c30 = _mm256_fmadd_ps(scalar, b0, c30);
+                c31 = _mm256_fmadd_ps(scalar, b1, c31);
+                scalar = _mm256_broadcast_ss(a + 4);
+                c40 = _mm256_fmadd_ps(scalar, b0, c40);
+                c41 = _mm256_fmadd_ps(scalar, b1, c41);
+                scalar = _mm256_broadcast_ss(a + 5);
+                c50 = _mm256_fmadd_ps(scalar, b0, c50);
+                c51 = _mm256_fmadd_ps(scalar, b1, c51);
+            }
+            const __m256 acc[kernel_rows][2] = {{c00, c01}, {c10, c11}, {c20, c21}, {c30, c31}, {c40, c41}, {c50, c51}};
+
+            if (rows == kernel_rows && cols == kernel_cols) {
+                for (std::size_t r = 0; r < kernel_rows; ++r) {
+                    float *row = c + r * ldc;
+                    _mm256_storeu_ps(row, _mm256_add_ps(_mm256_loadu_ps(row), acc[r][0]));
+                    _mm256_storeu_ps(row + 8, _mm256_add_ps(_mm256_loadu_ps(row + 8), acc[r][1]));
+                }
+                return;
+            }
+
+            // Edge block: the panels were padded with zeros, only the valid part is added.
+            alignas(32) float block[kernel_rows][kernel_cols];
+            for (std::size_t r = 0; r < kernel_rows; ++r) {
+                _mm256_store_ps(block[r], acc[r][0]);
+                _mm256_store_ps(block[r] + 8, acc[r][1]);
+            }
+            for (std::size_t r = 0; r < rows; ++r) {
+                for (std::size_t j = 0; j < cols; ++j) c[r * ldc + j] += block[r][j];
+            }
+        }
+
+        /**
+         * @brief Multiplies row-major float matrices, packing the operands into kernel-sized panels first.
+         */
+        static void multiply_packed(const Matrix &a, const Matrix &b, Matrix &c) {
+            const std::size_t strips = (column_block + kernel_cols - 1) / kernel_cols;
+            const std::size_t panels = (row_block + kernel_rows - 1) / kernel_rows;
+            Matrix packed_b(1, strips * kernel_cols * depth_block);
+            Matrix packed_a(1, panels * kernel_rows * depth_block);
+
+            for (std::size_t jb = 0; jb < b.n_cols; jb += column_block) {
+                const std::size_t cols = std::min(column_block, b.n_cols - jb);
+                for (std::size_t kb = 0; kb < a.n_cols; kb += depth_block) {
+                    const std::size_t depth = std::min(depth_block, a.n_cols - kb);
+
+                    // B[kb.., jb..] as 16-column strips, each row of a strip contiguous and zero-padded.
+                    float *pb = packed_b.values;
+                    for (std::size_t j = 0; j < cols; j += kernel_cols) {
+                        const std::size_t width = std::min(kernel_cols, cols - j);
+                        for (std::size_t k = 0; k < depth; ++k) {
+                            const float *source = b.values + (kb + k) * b.ld + jb + j;
+                            for (std::size_t x = 0; x < kernel_cols; ++x) *pb++ = x < width ? source[x] : 0.0f;
+                        }
+                    }
+
+                    for (std::size_t ib = 0; ib < a.n_rows; ib += row_block) {
+                        const std::size_t rows = std::min(row_block, a.n_rows - ib);
+
+                        // A[ib.., kb..] as 6-row panels, stored column by column and zero-padded.
+                        float *pa = packed_a.values;
+                        for (std::size_t i = 0; i < rows; i += kernel_rows) {
+                            const std::size_t height = std::min(kernel_rows, rows - i);
+                            for (std::size_t k = 0; k < depth; ++k) {
+                                for (std::size_t r = 0; r < kernel_rows; ++r) {
+                                    *pa++ = r < height ? a.values[(ib + i + r) * a.ld + kb + k] : 0.0f;
+                                }
+                            }
+                        }
+
+                        for (std::size_t i = 0; i < rows; i += kernel_rows) {
+                            for (std::size_t j = 0; j < cols; j += kernel_cols) {
+                                kernel(packed_a.values + i * depth, packed_b.values + j * depth, depth,
+                                       c.values + (ib + i) * c.ld + jb + j, c.ld, std::min(kernel_rows, rows - i),
+                                       std::min(kernel_cols, cols - j));
+                            }
+                        }
+                    }
+                }
+            }
+        }
+#endif
+
+    public:
+        /**
+         * @brief Constructs a matrix of zeros.
+         *
+         * @param rows The number of rows.
+         * @param cols The number of columns.
+         * @param layout The storage order.
+         */
+        explicit Matrix(const std::size_t rows = 0, const std::size_t cols = 0, const Layout layout = Layout::RowMajor)
+            : n_rows(rows), n_cols(cols), order(layout) {
+            const std::size_t inner = layout == Layout::RowMajor ? cols : rows;
+            ld = (inner + lanes - 1) / lanes * lanes;
+            values = allocate(storage_size());
+        }
+
+        Matrix(const Matrix &other) : n_rows(other.n_rows), n_cols(other.n_cols), order(other.order), ld(other.ld) {
+            values = allocate(storage_size());
+            if (values != nullptr) std::memcpy(values, other.values, storage_size() * sizeof(T));
+        }
+
+        Matrix(Matrix &&other) noexcept
+            : n_rows(other.n_rows), n_cols(other.n_cols), order(other.order), ld(other.ld), values(other.values) {
+            other.n_rows = other.n_cols = other.ld = 0;
+            other.values = nullptr;
+        }
+
+        Matrix &operator=(Matrix other) noexcept {
+            std::swap(n_rows, other.n_rows);
+            std::swap(n_cols, other.n_cols);
+            std::swap(order, other.order);
+            std::swap(ld, other.ld);
+            std::swap(values, other.values);
+            return *this;
+        }
+
+        ~Matrix() {
+            release(values);
+        }
+
+        std::size_t rows() const noexcept {
+            return n_rows;
+        }
+
+        std::size_t cols() const noexcept {
+            return n_cols;
+        }
+
+        Layout layout() const noexcept {
+            return order;
+        }
+
+        /**
+         * @brief Returns the distance, in elements, between the starts of two rows (row-major) or columns (column-major).
+         */
+        std::size_t leading_dimension() const noexcept {
+            return ld;
+        }
+
+        T *data() noexcept {
+            return values;
+        }
+
+        const T *data() const noexcept {
+            return values;
+        }
+
+        /**
+         * @brief Returns an element without bounds checking.
+         */
+        T &operator()(const std::size_t row, const std::size_t col) {
+            return values[offset(row, col)];
+        }
+
+        const T &operator()(const std::size_t row, const std::size_t col) const {
+            return values[offset(row, col)];
+        }
+
+        /**
+         * @brief Returns an element.
+         * @throws std::out_of_range If the row or the column is out of bounds.
+         */
+        T &at(const std::size_t row, const std::size_t col) {
+            if (row >= n_rows || col >= n_cols) throw std::out_of_range("Index out of bounds");
+            return values[offset(row, col)];
+        }
+
+        const T &at(const std::size_t row, const std::size_t col) const {
+            if (row >= n_rows || col >= n_cols) throw std::out_of_range("Index out of bounds");
+            return values[offset(row, col)];
+        }
+
+        /**
+         * @brief Returns a view of a row; contiguous for row-major matrices.
+         * @throws std::out_of_range If the row is out of bounds.
+         */
+        VectorView<T> row(const std::size_t index) {
+            if (index >= n_rows) throw std::out_of_range("Index out of bounds");
+            return {values + offset(index, 0), n_cols, order == Layout::RowMajor ? 1 : ld};
+        }
+
+        VectorView<const T> row(const std::size_t index) const {
+            if (index >= n_rows) throw std::out_of_range("Index out of bounds");
+            return {values + offset(index, 0), n_cols, order == Layout::RowMajor ? 1 : ld};
+        }
+
+        /**
+         * @brief Returns a view of a column; contiguous for column-major matrices.
+         * @throws std::out_of_range If the column is out of bounds.
+         */
+        VectorView<T> column(const std::size_t index) {
+            if (index >= n_cols) throw std::out_of_range("Index out of bounds");
+            return {values + offset(0, index), n_rows, order == Layout::RowMajor ? ld : 1};
+        }
+
+        VectorView<const T> column(const std::size_t index) const {
+            if (index >= n_cols) throw std::out_of_range("Index out of bounds");
+            return {values + offset(0, index), n_rows, order == Layout::RowMajor ? ld : 1};
+        }
+
+        /**
+         * @brief Sets every element to a value.
+         */
+        void fill(const T &value) {
+            for (std::size_t i = 0; i < n_rows; ++i) {
+                for (std::size_t j = 0; j < n_cols; ++j) values[offset(i, j)] = value;
+            }
+        }
+
+        /**
+         * @brief Returns a copy of the matrix stored in another layout.
+         */
+        Matrix with_layout(const Layout layout) const {
+            if (layout == order) return *this;
+
+            // The elements of a matrix in the other layout are those of its transpose in this one.
+            Matrix result(n_rows, n_cols, layout);
+            const std::size_t outer = order == Layout::RowMajor ? n_rows : n_cols;
+            const std::size_t inner = order == Layout::RowMajor ? n_cols : n_rows;
+            transpose_tiles(values, ld, result.values, result.ld, outer, inner);
+            return result;
+        }
+
+        /**
+         * @brief Returns the transpose, in the same layout.
+         */
+        Matrix transpose() const {
+            Matrix result(n_cols, n_rows, order);
+            const std::size_t outer = order == Layout::RowMajor ? n_rows : n_cols;
+            const std::size_t inner = order == Layout::RowMajor ? n_cols : n_rows;
+            transpose_tiles(values, ld, result.values, result.ld, outer, inner);
+            return result;
+        }
+
+        /**
+         * @brief Computes the product of two matrices as a row-major matrix.
+         *
+         * Operands that are not row-major are converted first.
+         *
+         * @throws std::runtime_error If the number of columns of a differs from the number of rows of b.
+         */
+        static Matrix multiply(const Matrix &a, const Matrix &b) {
+            if (a.n_cols != b.n_rows) throw std::runtime_error("Matrix dimensions do not match");
+            if (a.order != Layout::RowMajor) return multiply(a.with_layout(Layout::RowMajor), b);
+            if (b.order != Layout::RowMajor) return multiply(a, b.with_layout(Layout::RowMajor));
+
+            Matrix c(a.n_rows, b.n_cols, Layout::RowMajor);
+#if defined(__AVX2__) && defined(__FMA__)
+            if constexpr (std::is_same<T, float>::value) {
+                multiply_packed(a, b, c);
+                return c;
+            }
+#endif
+            for (std::size_t jb = 0; jb < b.n_cols; jb += column_block) {
+                const std::size_t cols = std::min(column_block, b.n_cols - jb);
+                for (std::size_t kb = 0; kb < a.n_cols; kb += depth_block) {
+                    const std::size_t depth = std::min(depth_block, a.n_cols - kb);
+                    // The panel B[kb.., jb..] is reused by every tile of rows below.
+                    for (std::size_t ib = 0; ib < a.n_rows; ib += row_block) {
+                        const std::size_t rows = std::min(row_block, a.n_rows - ib);
+                        multiply_tile(a.values + ib * a.ld + kb, a.ld, b.values + kb * b.ld + jb, b.ld,
+                                      c.values + ib * c.ld + jb, c.ld, rows, depth, cols);
+                    }
+                }
+            }
+            return c;
+        }
+
+        Matrix operator*(const Matrix &other) const {
+            return multiply(*this, other);
+        }
+
+        bool operator==(const Matrix &other) const {
+            if (n_rows != other.n_rows || n_cols != other.n_cols) return false;
+            for (std::size_t i = 0; i < n_rows; ++i) {
+                for (std::size_t j = 0; j < n_cols; ++j) {
+                    if ((*this)(i, j) != other(i, j)) return false;
+                }
+            }
+            return true;
+        }
+
+        bool operator!=(const Matrix &other) const {
+            return !(*this == other);
+        }
+
+        /**
+         * @brief Displays the matrix to the standard output, one row per line.
+         */
+        void show() const {
+            for (std::size_t i = 0; i < n_rows; ++i) {
+                std::cout << "{";
+                for (std::size_t j = 0; j < n_cols; ++j) {
+                    std::cout << (*this)(i, j);
+                    if (j + 1 < n_cols) {
+                        std::cout << ", ";
+                    }
+                }
+                std::cout << "}\n";
+            }
+        }
+    };
+} // DS
+
+#endif //MATRIX_H
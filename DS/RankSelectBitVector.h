@@ -0,0 +1,351 @@
+#ifndef RANKSELECTBITVECTOR_H
+#define RANKSELECTBITVECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+#include "Array.h"
+
+namespace DS {
+    /**
+     * @brief A static bitvector with constant-time rank and fast select.
+     *
+     * The rank directory follows the "poppy" layout: one 64-bit entry per 2048-bit block
+     * interleaves the number of ones before the block (32 bits, relative to its 2^32-bit
+     * region) with the popcounts of the block's first three 512-bit sub-blocks (10 bits
+     * each). A rank query reads one entry, adds at most three sub-block counts and
+     * popcounts at most eight words, all within one block. The directory costs 3.125% of
+     * the bits.
+     *
+     * select() starts from a sample taken every 8192 ones (or zeros), binary searches the
+     * blocks between two samples, walks the sub-blocks and words, and selects inside the
+     * final word with pdep when BMI2 is available, or with a broadword byte search
+     * otherwise. The samples cost at most 0.8% of the bits each.
+     *
+     * The bitvector is immutable once built; use Builder to stream bits into it.
+     */
+    class RankSelectBitVector {
+        static constexpr std::size_t words_per_block = 32;
+        static constexpr std::size_t words_per_sub_block = 8;
+        static constexpr std::size_t block_bits = 64 * words_per_block;
+        static constexpr std::size_t blocks_per_region = std::size_t{1} << 21; ///< 2^32 bits per region.
+        static constexpr std::size_t sample_rate = 8192;
+
+        std::vector<std::uint64_t> words;
+        std::size_t bits = 0;
+        std::size_t ones = 0;
+        std::vector<std::uint64_t> entries; ///< Interleaved block and sub-block counters, one per block.
+        std::vector<std::uint64_t> regions; ///< Ones before each 2^32-bit region.
+        std::vector<std::size_t> samples[2]; ///< samples[b][j] is the block holding the (j * sample_rate)-th b bit.
+
+        static unsigned popcount(const std::uint64_t word) {
+            return static_cast<unsigned>(__builtin_popcountll(word));
+        }
+
+        /**
+         * @brief Returns the position of the (rank + 1)-th set bit of a word; rank must be below popcount(word).
+         */
+        static unsigned select_in_word(const std::uint64_t word, unsigned rank) {
+#if defined(__BMI2__)
+            return static_cast<unsigned>(__builtin_ctzll(_pdep_u64(std::uint64_t{1} << rank, word)));
+#else
+            constexpr std::uint64_t ones_step8 = 0x0101010101010101ULL;
+            constexpr std::uint64_t high_step8 = 0x8080808080808080ULL;
+
+            // Byte-wise popcounts, then their prefix sums with one multiply.
+            std::uint64_t sums = word - ((word >> 1) & 0x5555555555555555ULL);
+            sums = (sums & 0x3333333333333333ULL) + ((sums >> 2) & 0x3333333333333333ULL);
+            sums = ((sums + (sums >> 4)) & 0x0F0F0F0F0F0F0F0FULL) * ones_step8;
+
+            // Broadcast the rank to every byte and count the bytes whose prefix sum is at most the rank.
+            const std::uint64_t at_most = ((rank * ones_step8 | high_step8) - sums) & high_step8;
+            const unsigned byte = popcount(at_most) * 8;
+
+            rank -= static_cast<unsigned>(((sums << 8) >> byte) & 0xFF);
+            std::uint64_t rest = (word >> byte) & 0xFF;
+            for (; rank > 0; --rank) rest &= rest - 1;
+            return byte + static_cast<unsigned>(__builtin_ctzll(rest));
+#endif
+        }
+
+        std::size_t block_count() const {
+            return entries.size();
+        }
+
+        /**
+         * @brief Returns the number of ones before a block.
+         */
+        std::uint64_t ones_before(const std::size_t block) const {
+            return regions[block / blocks_per_region] + (entries[block] & 0xFFFFFFFFULL);
+        }
+
+        static unsigned sub_block_ones(const std::uint64_t entry, const std::size_t sub_block) {
+            return static_cast<unsigned>((entry >> (32 + 10 * sub_block)) & 0x3FF);
+        }
+
+        template<bool bit>
+        std::uint64_t before(const std::size_t block) const {
+            const std::uint64_t set = ones_before(block);
+            return bit ? set : static_cast<std::uint64_t>(block) * block_bits - set;
+        }
+
+        void build_directory() {
+            const std::size_t blocks = (words.size() + words_per_block - 1) / words_per_block;
+            entries.assign(blocks, 0);
+            regions.assign((blocks + blocks_per_region - 1) / blocks_per_region, 0);
+            samples[0].clear();
+            samples[1].clear();
+
+            std::uint64_t total = 0;
+            std::uint64_t zeros = 0;
+            for (std::size_t block = 0; block < blocks; ++block) {
+                if (block % blocks_per_region == 0) regions[block / blocks_per_region] = total;
+
+                std::uint64_t entry = total - regions[block / blocks_per_region];
+                std::uint64_t in_block = 0;
+                for (std::size_t sub = 0; sub < 4; ++sub) {
+                    std::uint64_t count = 0;
+                    const std::size_t first = block * words_per_block + sub * words_per_sub_block;
+                    for (std::size_t w = first; w < first + words_per_sub_block && w < words.size(); ++w) {
+                        count += popcount(words[w]);
+                    }
+                    if (sub < 3) entry |= count << (32 + 10 * sub);
+                    in_block += count;
+                }
+                entries[block] = entry;
+
+                // Samples of the bits that fall inside this block.
+                const std::uint64_t block_zeros = std::min<std::uint64_t>(block_bits, bits - block * block_bits) - in_block;
+                while (samples[1].size() * sample_rate < total + in_block) samples[1].push_back(block);
+                while (samples[0].size() * sample_rate < zeros + block_zeros) samples[0].push_back(block);
+
+                total += in_block;
+                zeros += block_zeros;
+            }
+            ones = static_cast<std::size_t>(total);
+        }
+
+        template<bool bit>
+        std::size_t select_bit(const std::size_t rank) const {
+            const std::size_t available = bit ? ones : bits - ones;
+            if (rank >= available) throw std::out_of_range("Rank out of bounds");
+
+            // The sampled blocks bracket the answer; binary search for the last block starting at or before it.
+            const std::vector<std::size_t> &sampled = samples[bit];
+            const std::size_t sample = rank / sample_rate;
+            std::size_t low = sampled[sample];
+            std::size_t high = sample + 1 < sampled.size() ? sampled[sample + 1] + 1 : block_count();
+            while (high - low > 1) {
+                const std::size_t mid = (low + high) / 2;
+                if (before<bit>(mid) <= rank) low = mid;
+                else high = mid;
+            }
+
+            const std::size_t block = low;
+            auto remaining = static_cast<std::size_t>(rank - before<bit>(block));
+            const std::uint64_t entry = entries[block];
+
+            std::size_t word = block * words_per_block;
+            for (std::size_t sub = 0; sub < 3; ++sub) {
+                const std::size_t count = bit ? sub_block_ones(entry, sub)
+                                              : 64 * words_per_sub_block - sub_block_ones(entry, sub);
+                if (remaining < count) break;
+                remaining -= count;
+                word += words_per_sub_block;
+            }
+
+            for (;; ++word) {
+                const std::uint64_t value = bit ? words[word] : ~words[word];
+                const std::size_t count = popcount(value);
+                if (remaining < count) {
+                    return 64 * word + select_in_word(value, static_cast<unsigned>(remaining));
+                }
+                remaining -= count;
+            }
+        }
+
+    public:
+        /**
+         * @brief Streams bits into a new RankSelectBitVector.
+         */
+        class Builder {
+            std::vector<std::uint64_t> words;
+            std::size_t bits = 0;
+
+        public:
+            /**
+             * @brief Reserves room for a number of bits.
+             */
+            void reserve(const std::size_t count) {
+                words.reserve((count + 63) / 64);
+            }
+
+            /**
+             * @brief Appends one bit.
+             */
+            void push_back(const bool bit) {
+                if (bits % 64 == 0) words.push_back(0);
+                words.back() |= static_cast<std::uint64_t>(bit) << (bits % 64);
+                ++bits;
+            }
+
+            /**
+             * @brief Appends the low count bits of a word, least significant bit first.
+             * @param value The bits to append.
+             * @param count The number of bits, at most 64.
+             * @throws std::runtime_error If count is greater than 64.
+             */
+            void append(std::uint64_t value, const unsigned count) {
+                if (count > 64) throw std::runtime_error("Invalid bit count");
+                if (count == 0) return;
+                if (count < 64) value &= (std::uint64_t{1} << count) - 1;
+
+                const unsigned used = bits % 64;
+                if (used == 0) {
+                    words.push_back(value);
+                } else {
+                    words.back() |= value << used;
+                    if (used + count > 64) words.push_back(value >> (64 - used));
+                }
+                bits += count;
+            }
+
+            std::size_t size() const noexcept {
+                return bits;
+            }
+
+            /**
+             * @brief Builds the bitvector, leaving the builder empty.
+             */
+            RankSelectBitVector build() {
+                RankSelectBitVector result(std::move(words), bits);
+                words.clear();
+                bits = 0;
+                return result;
+            }
+        };
+
+        RankSelectBitVector() = default;
+
+        /**
+         * @brief Builds a bitvector from packed words; bit i is bit (i % 64) of words[i / 64].
+         * @param packed The words.
+         * @param size The number of bits; bits of the last word past size are ignored.
+         * @throws std::runtime_error If the words hold fewer than size bits.
+         */
+        RankSelectBitVector(std::vector<std::uint64_t> packed, const std::size_t size)
+            : words(std::move(packed)), bits(size) {
+            if (words.size() * 64 < bits) throw std::runtime_error("Not enough words for the bit count");
+
+            words.resize((bits + 63) / 64);
+            if (bits % 64 != 0) words.back() &= (std::uint64_t{1} << (bits % 64)) - 1;
+            build_directory();
+        }
+
+        /**
+         * @brief Builds a bitvector from a DS::Array of bools.
+         */
+        explicit RankSelectBitVector(const Array<bool> &array) {
+            Builder builder;
+            builder.reserve(static_cast<std::size_t>(array.size()));
+            for (int i = 0; i < array.size(); ++i) builder.push_back(array.at(i));
+            *this = builder.build();
+        }
+
+        /**
+         * @brief Returns the number of bits.
+         */
+        std::size_t size() const noexcept {
+            return bits;
+        }
+
+        bool empty() const noexcept {
+            return bits == 0;
+        }
+
+        /**
+         * @brief Returns the number of set bits.
+         */
+        std::size_t count_ones() const noexcept {
+            return ones;
+        }
+
+        /**
+         * @brief Returns the number of bytes used by the bits, the rank directory and the select samples.
+         */
+        std::size_t size_in_bytes() const noexcept {
+            return (words.size() + entries.size() + regions.size()) * sizeof(std::uint64_t) +
+                   (samples[0].size() + samples[1].size()) * sizeof(std::size_t);
+        }
+
+        /**
+         * @brief Returns the bit at a position.
+         * @throws std::out_of_range If the position is out of bounds.
+         */
+        bool get(const std::size_t position) const {
+            if (position >= bits) throw std::out_of_range("Index out of bounds");
+            return (words[position / 64] >> (position % 64)) & 1;
+        }
+
+        bool operator[](const std::size_t position) const {
+            return get(position);
+        }
+
+        /**
+         * @brief Returns the number of ones in [0, end).
+         * @throws std::out_of_range If end is greater than size().
+         */
+        std::size_t rank1(const std::size_t end) const {
+            if (end > bits) throw std::out_of_range("Index out of bounds");
+            if (end == bits) return ones;
+
+            const std::size_t block = end / block_bits;
+            const std::uint64_t entry = entries[block];
+            std::uint64_t count = ones_before(block);
+
+            const std::size_t sub_blocks = (end / 512) % 4;
+            for (std::size_t sub = 0; sub < sub_blocks; ++sub) count += sub_block_ones(entry, sub);
+
+            const std::size_t last = end / 64;
+            for (std::size_t w = block * words_per_block + sub_blocks * words_per_sub_block; w < last; ++w) {
+                count += popcount(words[w]);
+            }
+            if (end % 64 != 0) count += popcount(words[last] & ((std::uint64_t{1} << (end % 64)) - 1));
+            return static_cast<std::size_t>(count);
+        }
+
+        /**
+         * @brief Returns the number of zeros in [0, end).
+         * @throws std::out_of_range If end is greater than size().
+         */
+        std::size_t rank0(const std::size_t end) const {
+            return end - rank1(end);
+        }
+
+        /**
+         * @brief Returns the position of the (rank + 1)-th one, so select1(0) is the first one.
+         * @throws std::out_of_range If rank is not less than count_ones().
+         */
+        std::size_t select1(const std::size_t rank) const {
+            return select_bit<true>(rank);
+        }
+
+        /**
+         * @brief Returns the position of the (rank + 1)-th zero, so select0(0) is the first zero.
+         * @throws std::out_of_range If rank is not less than the number of zeros.
+         */
+        std::size_t select0(const std::size_t rank) const {
+            return select_bit<false>(rank);
+        }
+    };
+} // DS
+
+#endif //RANKSELECTBITVECTOR_H
@@ -0,0 +1,246 @@
+#ifndef RCU_H
+#define RCU_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "ThreadRegistry.h"
+
+namespace DS {
+    /**
+     * @brief Quiescent-state-based read-copy-update (QSBR RCU).
+     *
+     * Readers access shared data inside read-side critical sections, delimited by
+     * ReadGuard, without locks and without writing to shared memory. A writer replaces
+     * the data with a new version and then waits for a grace period, after which no
+     * reader can still hold the old version, before freeing it.
+     *
+     * Grace periods are detected from quiescent states: every thread that reads owns a
+     * record holding the last grace period counter it has observed outside a critical
+     * section. A thread reports a quiescent state at the end of its outermost critical
+     * section, but only writes its record when a grace period is actually pending, so
+     * in the steady state readers write nothing at all.
+     *
+     * A thread is online from its first ReadGuard until it calls offline() or exits. An
+     * online thread that stops reading delays writers until it reads again or calls
+     * quiescent_state(), so threads that go idle should call offline().
+     */
+    class Rcu {
+        struct alignas(64) Record : ThreadRecord<Record> {
+            std::atomic<std::uint64_t> observed{0}; ///< Last grace period counter observed; 0 while offline.
+            unsigned nesting = 0;
+
+            /**
+             * @brief Takes the exiting thread offline.
+             */
+            void release() {
+                observed.store(0, std::memory_order_release);
+            }
+        };
+
+        struct Registry {
+            std::atomic<std::uint64_t> counter{1}; ///< Grace period counter.
+            ThreadRegistry<Record> threads;
+            std::mutex writers; ///< Serializes grace periods.
+        };
+
+        static Registry &registry() {
+            static Registry instance;
+            return instance;
+        }
+
+        static Record &local() {
+            return registry().threads.local();
+        }
+
+        static void go_online(Record &record) {
+            record.observed.store(registry().counter.load(std::memory_order_acquire), std::memory_order_relaxed);
+            // The record must be visible to writers before any shared pointer is read.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+
+        static void report(Record &record) {
+            // Acquiring the counter also makes every version published before it visible.
+            const std::uint64_t counter = registry().counter.load(std::memory_order_acquire);
+            if (record.observed.load(std::memory_order_relaxed) != counter) {
+                record.observed.store(counter, std::memory_order_release);
+            }
+        }
+
+    public:
+        /**
+         * @brief Delimits a read-side critical section. Guards may be nested.
+         *
+         * Pointers read inside the section stay valid until the outermost guard is destroyed.
+         */
+        class ReadGuard {
+            Record &record;
+
+        public:
+            ReadGuard() : record(local()) {
+                if (record.nesting++ == 0 && record.observed.load(std::memory_order_relaxed) == 0) {
+                    go_online(record);
+                }
+            }
+
+            ~ReadGuard() {
+                if (--record.nesting == 0) report(record);
+            }
+
+            ReadGuard(const ReadGuard &) = delete;
+
+            ReadGuard &operator=(const ReadGuard &) = delete;
+        };
+
+        /**
+         * @brief Reports that the calling thread holds no pointer read in an earlier critical section.
+         *
+         * Has no effect inside a critical section.
+         */
+        static void quiescent_state() {
+            Record &record = local();
+            if (record.nesting == 0 && record.observed.load(std::memory_order_relaxed) != 0) report(record);
+        }
+
+        /**
+         * @brief Stops the calling thread from delaying grace periods until its next critical section.
+         *
+         * @throws std::runtime_error If called inside a critical section.
+         */
+        static void offline() {
+            Record &record = local();
+            if (record.nesting != 0) throw std::runtime_error("offline() inside a read-side critical section");
+            record.observed.store(0, std::memory_order_release);
+        }
+
+        /**
+         * @brief Waits for a grace period: returns once every critical section in progress at the call has ended.
+         *
+         * @throws std::runtime_error If called inside a critical section, which would wait forever.
+         */
+        static void synchronize() {
+            Record &self = local();
+            if (self.nesting != 0) throw std::runtime_error("synchronize() inside a read-side critical section");
+
+            // The caller does not read while it waits, so it must not hold up its own grace period.
+            const bool was_online = self.observed.load(std::memory_order_relaxed) != 0;
+            self.observed.store(0, std::memory_order_release);
+
+            Registry &shared = registry();
+            {
+                std::lock_guard<std::mutex> lock(shared.writers);
+                const std::uint64_t target = shared.counter.fetch_add(1, std::memory_order_seq_cst) + 1;
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                for (Record *record = shared.threads.first(); record != nullptr;
+                     record = record->next) {
+                    for (;;) {
+                        const std::uint64_t observed = record->observed.load(std::memory_order_acquire);
+                        if (observed == 0 || observed >= target) break;
+                        std::this_thread::yield();
+                    }
+                }
+            }
+
+            if (was_online) go_online(self);
+        }
+    };
+
+    /**
+     * @brief A pointer to an immutable version of a value, replaced with read-copy-update.
+     *
+     * Readers get the current version with read() inside an Rcu::ReadGuard; this is a
+     * single atomic load. Writers build a new version, publish it with one atomic
+     * exchange and free the old version after a grace period. Writers are serialized
+     * with each other and block for the grace period, so updates should be rare.
+     *
+     * @tparam T The type of the value.
+     */
+    template<typename T>
+    class RcuPointer {
+        std::atomic<const T *> current;
+        std::mutex writer;
+
+        /**
+         * @brief Swaps in a new version and frees the old one after a grace period. Caller holds the writer lock.
+         *
+         * Callers go offline before taking the lock: a thread blocked on it while online
+         * would hold up the grace period of the thread that owns it, which waits forever.
+         */
+        void replace(const T *version) {
+            const T *old = current.exchange(version, std::memory_order_acq_rel);
+            Rcu::synchronize();
+            delete old;
+        }
+
+    public:
+        /**
+         * @brief Takes ownership of the initial version.
+         *
+         * @param version The initial version; must not be null.
+         * @throws std::runtime_error If the version is null.
+         */
+        explicit RcuPointer(std::unique_ptr<T> version) {
+            if (!version) throw std::runtime_error("Null version");
+            current.store(version.release(), std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Frees the current version. Must not run concurrently with any reader.
+         */
+        ~RcuPointer() {
+            delete current.load(std::memory_order_relaxed);
+        }
+
+        RcuPointer(const RcuPointer &) = delete;
+
+        RcuPointer &operator=(const RcuPointer &) = delete;
+
+        /**
+         * @brief Returns the current version. Must be called inside an Rcu::ReadGuard.
+         *
+         * The version stays valid until the outermost guard of the calling thread ends.
+         */
+        const T *read() const noexcept {
+            return current.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Publishes a new version and frees the old one after a grace period.
+         *
+         * Must not be called inside a read-side critical section.
+         *
+         * @param version The new version; must not be null.
+         * @throws std::runtime_error If the version is null.
+         */
+        void publish(std::unique_ptr<T> version) {
+            if (!version) throw std::runtime_error("Null version");
+            Rcu::offline();
+            std::lock_guard<std::mutex> lock(writer);
+            replace(version.release());
+        }
+
+        /**
+         * @brief Copies the current version, modifies the copy and publishes it.
+         *
+         * Must not be called inside a read-side critical section.
+         *
+         * @param fn Called with a copy of the current version to modify.
+         */
+        template<typename Fn>
+        void update(Fn fn) {
+            Rcu::offline();
+            std::lock_guard<std::mutex> lock(writer);
+            std::unique_ptr<T> next(new T(*current.load(std::memory_order_relaxed)));
+            fn(*next);
+            replace(next.release());
+        }
+    };
+} // DS
+
+#endif //RCU_H
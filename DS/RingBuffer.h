@@ -0,0 +1,263 @@
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Array.h"
+
+namespace DS {
+    /**
+     * @brief A fixed-capacity circular buffer that overwrites its oldest element when full.
+     *
+     * Elements are indexed logically, from 0 for the oldest to size() - 1 for the newest.
+     * The only state besides the slots is the total number of pushes, from which the
+     * position of every element follows; power-of-two capacities map positions to slots
+     * with a mask instead of a division.
+     *
+     * One writer may push while other threads call snapshot() concurrently; every other
+     * member function must not run concurrently with push_back().
+     *
+     * @tparam T The type of the elements. Must be default constructible.
+     */
+    template<typename T>
+    class RingBuffer {
+    public:
+        /**
+         * @brief A contiguous range of elements.
+         */
+        struct Span {
+            const T *data;
+            std::size_t size;
+
+            const T *begin() const noexcept {
+                return data;
+            }
+
+            const T *end() const noexcept {
+                return data + size;
+            }
+        };
+
+    private:
+        std::vector<T> slots;
+        std::size_t mask; ///< capacity - 1 if the capacity is a power of two, 0 otherwise.
+        std::atomic<std::uint64_t> written{0}; ///< Total number of pushes; the newest element is at written - 1.
+        std::atomic<std::uint64_t> started{0}; ///< Pushes begun; runs one ahead of written while a push is storing.
+
+        std::size_t slot(const std::uint64_t position) const noexcept {
+            if (mask != 0) return static_cast<std::size_t>(position & mask);
+            return static_cast<std::size_t>(position % slots.size());
+        }
+
+        std::uint64_t oldest() const noexcept {
+            return written.load(std::memory_order_relaxed) - size();
+        }
+
+    public:
+        /**
+         * @brief Constructs an empty ring buffer.
+         *
+         * @param capacity The maximum number of elements kept.
+         * @throws std::runtime_error If the capacity is zero.
+         */
+        explicit RingBuffer(const std::size_t capacity) : slots(capacity) {
+            if (capacity == 0) throw std::runtime_error("Invalid capacity");
+            mask = (capacity & (capacity - 1)) == 0 && capacity > 1 ? capacity - 1 : 0;
+        }
+
+        RingBuffer(const RingBuffer &) = delete;
+
+        RingBuffer &operator=(const RingBuffer &) = delete;
+
+        /**
+         * @brief Appends an element, overwriting the oldest one if the buffer is full.
+         *
+         * @param value The element to append.
+         * @return true if an element was overwritten.
+         */
+        bool push_back(const T &value) {
+            const std::uint64_t position = written.load(std::memory_order_relaxed);
+            started.store(position + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            slots[slot(position)] = value;
+            // Publish the element to concurrent snapshot() calls.
+            written.store(position + 1, std::memory_order_release);
+            return position >= slots.size();
+        }
+
+        bool push_back(T &&value) {
+            const std::uint64_t position = written.load(std::memory_order_relaxed);
+            started.store(position + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            slots[slot(position)] = std::move(value);
+            written.store(position + 1, std::memory_order_release);
+            return position >= slots.size();
+        }
+
+        /**
+         * @brief Returns an element by logical index without bounds checking.
+         *
+         * @param index 0 for the oldest element, size() - 1 for the newest.
+         */
+        const T &operator[](const std::size_t index) const {
+            return slots[slot(oldest() + index)];
+        }
+
+        T &operator[](const std::size_t index) {
+            return slots[slot(oldest() + index)];
+        }
+
+        /**
+         * @brief Returns an element by logical index.
+         *
+         * @param index 0 for the oldest element, size() - 1 for the newest.
+         * @throws std::out_of_range If the index is not less than size().
+         */
+        const T &at(const std::size_t index) const {
+            if (index >= size()) throw std::out_of_range("Index out of bounds");
+            return (*this)[index];
+        }
+
+        /**
+         * @brief Returns the oldest element.
+         * @throws std::runtime_error If the buffer is empty.
+         */
+        const T &front() const {
+            if (empty()) throw std::runtime_error("RingBuffer is empty");
+            return (*this)[0];
+        }
+
+        /**
+         * @brief Returns the newest element.
+         * @throws std::runtime_error If the buffer is empty.
+         */
+        const T &back() const {
+            if (empty()) throw std::runtime_error("RingBuffer is empty");
+            return (*this)[size() - 1];
+        }
+
+        std::size_t size() const noexcept {
+            const std::uint64_t count = written.load(std::memory_order_relaxed);
+            return count < slots.size() ? static_cast<std::size_t>(count) : slots.size();
+        }
+
+        std::size_t capacity() const noexcept {
+            return slots.size();
+        }
+
+        bool empty() const noexcept {
+            return written.load(std::memory_order_relaxed) == 0;
+        }
+
+        bool full() const noexcept {
+            return written.load(std::memory_order_relaxed) >= slots.size();
+        }
+
+        /**
+         * @brief Returns the number of elements ever pushed, including overwritten ones.
+         */
+        std::uint64_t total_pushed() const noexcept {
+            return written.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Removes every element. The slots keep their old values until overwritten.
+         */
+        void clear() noexcept {
+            written.store(0, std::memory_order_relaxed);
+            started.store(0, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Returns the older of the two contiguous ranges that hold the elements, oldest first.
+         *
+         * The elements in order are first_span() followed by second_span().
+         */
+        Span first_span() const noexcept {
+            const std::size_t start = slot(oldest());
+            const std::size_t count = size();
+            return {slots.data() + start, std::min(count, slots.size() - start)};
+        }
+
+        /**
+         * @brief Returns the newer of the two contiguous ranges that hold the elements; empty if the elements do not wrap.
+         */
+        Span second_span() const noexcept {
+            const std::size_t start = slot(oldest());
+            const std::size_t count = size();
+            const std::size_t tail = slots.size() - start;
+            return {slots.data(), count > tail ? count - tail : 0};
+        }
+
+        /**
+         * @brief Copies a consistent window of the newest elements while one writer may push concurrently.
+         *
+         * The copy is lock-free and never blocks the writer: the slots are copied
+         * optimistically, and elements the writer may have overwritten meanwhile are
+         * dropped from the front of the result, so fewer than size() elements may be
+         * returned. The copied elements may be torn while the copy is in progress, so T
+         * must be trivially copyable.
+         *
+         * @param out At least capacity() elements; receives the elements, oldest first.
+         * @return The number of elements written to out.
+         */
+        std::size_t snapshot(T *out) const {
+            static_assert(std::is_trivially_copyable<T>::value, "snapshot() requires a trivially copyable type");
+
+            const std::uint64_t end = written.load(std::memory_order_acquire);
+            const std::uint64_t begin = end - std::min<std::uint64_t>(end, slots.size());
+            for (std::uint64_t position = begin; position < end; ++position) {
+                out[position - begin] = slots[slot(position)];
+            }
+
+            // Every push begun since the copy started may have overwritten the slot of an older position.
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const std::uint64_t now = started.load(std::memory_order_relaxed);
+            const std::uint64_t valid = now > slots.size() ? now - slots.size() : 0;
+            if (valid <= begin) return static_cast<std::size_t>(end - begin);
+            if (valid >= end) return 0;
+
+            const std::size_t dropped = static_cast<std::size_t>(valid - begin);
+            std::copy(out + dropped, out + (end - begin), out);
+            return static_cast<std::size_t>(end - valid);
+        }
+
+        /**
+         * @brief Appends the elements, oldest first, to a DS::Array.
+         *
+         * @param array The array to append to.
+         */
+        void append_to(Array<T> &array) const {
+            for (const Span span: {first_span(), second_span()}) {
+                for (const T &value: span) array.push_back(value);
+            }
+        }
+
+        /**
+         * @brief Displays the elements, oldest first, to the standard output.
+         */
+        void show() const {
+            std::cout << "{";
+
+            const std::size_t count = size();
+            for (std::size_t i = 0; i < count; ++i) {
+                std::cout << (*this)[i];
+                if (i + 1 < count) {
+                    std::cout << ", ";
+                }
+            }
+
+            std::cout << "}\n";
+        }
+    };
+} // DS
+
+#endif //RINGBUFFER_H
@@ -0,0 +1,1053 @@
+#ifndef ROARINGBITMAP_H
+#define ROARINGBITMAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "Array.h"
+
+namespace DS {
+    /**
+     * @brief A compressed bitmap of 32-bit integers (Roaring bitmap).
+     *
+     * The 32-bit space is split into 2^16 chunks by the high 16 bits of each value. Every
+     * non-empty chunk has a container for the low 16 bits, in one of three forms:
+     *  - array: sorted 16-bit values, used for at most 4096 values (2 bytes per value);
+     *  - bitset: 2^16 bits in 1024 words, used above 4096 values (8 KiB);
+     *  - run: sorted (start, length - 1) pairs, chosen by run_optimize() when smaller.
+     *
+     * Sparse chunks therefore cost 2 bytes per value, dense chunks at most 1 bit per
+     * possible value, and long runs a few bytes each. Set operations work chunk by chunk;
+     * bitset-bitset kernels process 256 bits per step with AVX2. Results of set operations
+     * are stored as arrays and bitsets; call run_optimize() to re-encode runs.
+     */
+    class RoaringBitmap {
+        static constexpr char magic[4] = {'D', 'S', 'R', 'B'};
+        static constexpr std::uint32_t format_version = 1;
+        static constexpr std::uint32_t array_limit = 4096; ///< Largest array container.
+        static constexpr std::size_t bitset_words = 1024;
+
+        enum class Op { And, Or, Xor, AndNot };
+
+        struct Container {
+            enum Kind : std::uint8_t { array_kind, bitset_kind, run_kind };
+
+            Kind kind = array_kind;
+            std::uint32_t cardinality = 0;
+            std::vector<std::uint16_t> values; ///< Array: sorted values. Run: start, length - 1 pairs.
+            std::vector<std::uint64_t> words; ///< Bitset: 1024 words.
+
+            std::size_t run_count() const {
+                return values.size() / 2;
+            }
+
+            std::uint32_t run_start(const std::size_t run) const {
+                return values[2 * run];
+            }
+
+            std::uint32_t run_end(const std::size_t run) const {
+                return static_cast<std::uint32_t>(values[2 * run]) + values[2 * run + 1];
+            }
+
+            /**
+             * @brief Returns the number of runs whose start is at most low.
+             */
+            std::size_t runs_starting_at_or_before(const std::uint32_t low) const {
+                std::size_t begin = 0;
+                std::size_t end = run_count();
+                while (begin < end) {
+                    const std::size_t mid = (begin + end) / 2;
+                    if (run_start(mid) <= low) begin = mid + 1;
+                    else end = mid;
+                }
+                return begin;
+            }
+
+            bool contains(const std::uint16_t low) const {
+                switch (kind) {
+                    case array_kind:
+                        return std::binary_search(values.begin(), values.end(), low);
+                    case bitset_kind:
+                        return (words[low >> 6] >> (low & 63)) & 1;
+                    default: {
+                        const std::size_t run = runs_starting_at_or_before(low);
+                        return run > 0 && low <= run_end(run - 1);
+                    }
+                }
+            }
+
+            bool add(const std::uint16_t low) {
+                switch (kind) {
+                    case array_kind: {
+                        const auto position = std::lower_bound(values.begin(), values.end(), low);
+                        if (position != values.end() && *position == low) return false;
+                        if (cardinality == array_limit) {
+                            to_bitset();
+                            return add(low);
+                        }
+                        values.insert(position, low);
+                        break;
+                    }
+                    case bitset_kind: {
+                        std::uint64_t &word = words[low >> 6];
+                        const std::uint64_t bit = std::uint64_t{1} << (low & 63);
+                        if (word & bit) return false;
+                        word |= bit;
+                        break;
+                    }
+                    default:
+                        if (!add_to_runs(low)) return false;
+                }
+                ++cardinality;
+                return true;
+            }
+
+            bool add_to_runs(const std::uint32_t low) {
+                const std::size_t run = runs_starting_at_or_before(low);
+                const bool joins_next = run < run_count() && run_start(run) == low + 1;
+
+                if (run > 0) {
+                    const std::uint32_t end = run_end(run - 1);
+                    if (low <= end) return false;
+                    if (low == end + 1) {
+                        if (joins_next) {
+                            values[2 * (run - 1) + 1] = static_cast<std::uint16_t>(run_end(run) - run_start(run - 1));
+                            values.erase(values.begin() + static_cast<std::ptrdiff_t>(2 * run),
+                                         values.begin() + static_cast<std::ptrdiff_t>(2 * run + 2));
+                        } else {
+                            ++values[2 * (run - 1) + 1];
+                        }
+                        return true;
+                    }
+                }
+
+                if (joins_next) {
+                    values[2 * run] = static_cast<std::uint16_t>(low);
+                    ++values[2 * run + 1];
+                } else {
+                    const std::uint16_t fresh[2] = {static_cast<std::uint16_t>(low), 0};
+                    values.insert(values.begin() + static_cast<std::ptrdiff_t>(2 * run), fresh, fresh + 2);
+                }
+                return true;
+            }
+
+            bool remove(const std::uint16_t low) {
+                switch (kind) {
+                    case array_kind: {
+                        const auto position = std::lower_bound(values.begin(), values.end(), low);
+                        if (position == values.end() || *position != low) return false;
+                        values.erase(position);
+                        break;
+                    }
+                    case bitset_kind: {
+                        std::uint64_t &word = words[low >> 6];
+                        const std::uint64_t bit = std::uint64_t{1} << (low & 63);
+                        if (!(word & bit)) return false;
+                        word &= ~bit;
+                        if (cardinality - 1 <= array_limit) {
+                            --cardinality;
+                            to_array();
+                            return true;
+                        }
+                        break;
+                    }
+                    default: {
+                        const std::size_t run = runs_starting_at_or_before(low);
+                        if (run == 0 || low > run_end(run - 1)) return false;
+
+                        const std::size_t at = 2 * (run - 1);
+                        const std::uint32_t start = run_start(run - 1);
+                        const std::uint32_t end = run_end(run - 1);
+                        if (start == end) {
+                            values.erase(values.begin() + static_cast<std::ptrdiff_t>(at),
+                                         values.begin() + static_cast<std::ptrdiff_t>(at + 2));
+                        } else if (low == start) {
+                            ++values[at];
+                            --values[at + 1];
+                        } else if (low == end) {
+                            --values[at + 1];
+                        } else {
+                            values[at + 1] = static_cast<std::uint16_t>(low - 1 - start);
+                            const std::uint16_t rest[2] = {
+                                static_cast<std::uint16_t>(low + 1), static_cast<std::uint16_t>(end - low - 1)
+                            };
+                            values.insert(values.begin() + static_cast<std::ptrdiff_t>(at + 2), rest, rest + 2);
+                        }
+                    }
+                }
+                --cardinality;
+                return true;
+            }
+
+            /**
+             * @brief Returns the number of values that are less than or equal to low.
+             */
+            std::uint32_t rank(const std::uint16_t low) const {
+                switch (kind) {
+                    case array_kind:
+                        return static_cast<std::uint32_t>(std::upper_bound(values.begin(), values.end(), low) -
+                                                          values.begin());
+                    case bitset_kind: {
+                        std::uint32_t count = 0;
+                        const std::size_t last = low >> 6;
+                        for (std::size_t i = 0; i < last; ++i) count += popcount(words[i]);
+                        const std::uint64_t mask = (low & 63) == 63 ? ~std::uint64_t{0}
+                                                                    : (std::uint64_t{2} << (low & 63)) - 1;
+                        return count + popcount(words[last] & mask);
+                    }
+                    default: {
+                        const std::size_t runs = runs_starting_at_or_before(low);
+                        std::uint32_t count = 0;
+                        for (std::size_t i = 0; i + 1 < runs; ++i) count += values[2 * i + 1] + 1U;
+                        if (runs > 0) count += std::min<std::uint32_t>(low, run_end(runs - 1)) - run_start(runs - 1) + 1;
+                        return count;
+                    }
+                }
+            }
+
+            /**
+             * @brief Calls fn(low) for every value, in increasing order.
+             */
+            template<typename Fn>
+            void for_each(Fn fn) const {
+                switch (kind) {
+                    case array_kind:
+                        for (const std::uint16_t low: values) fn(low);
+                        break;
+                    case bitset_kind:
+                        for (std::size_t i = 0; i < bitset_words; ++i) {
+                            for (std::uint64_t word = words[i]; word != 0; word &= word - 1) {
+                                fn(static_cast<std::uint16_t>(i * 64 + static_cast<std::size_t>(__builtin_ctzll(word))));
+                            }
+                        }
+                        break;
+                    default:
+                        for (std::size_t run = 0; run < run_count(); ++run) {
+                            for (std::uint32_t low = run_start(run); low <= run_end(run); ++low) {
+                                fn(static_cast<std::uint16_t>(low));
+                            }
+                        }
+                }
+            }
+
+            void to_bitset() {
+                std::vector<std::uint64_t> bits(bitset_words, 0);
+                if (kind == run_kind) {
+                    for (std::size_t run = 0; run < run_count(); ++run) set_range(bits.data(), run_start(run), run_end(run));
+                } else {
+                    for (const std::uint16_t low: values) bits[low >> 6] |= std::uint64_t{1} << (low & 63);
+                }
+                words = std::move(bits);
+                values = std::vector<std::uint16_t>();
+                kind = bitset_kind;
+            }
+
+            void to_array() {
+                std::vector<std::uint16_t> array;
+                array.reserve(cardinality);
+                for_each([&array](const std::uint16_t low) { array.push_back(low); });
+                values = std::move(array);
+                words = std::vector<std::uint64_t>();
+                kind = array_kind;
+            }
+
+            void to_runs() {
+                std::vector<std::uint16_t> runs;
+                std::uint32_t start = 0;
+                std::uint32_t previous = 0;
+                bool open = false;
+
+                for_each([&](const std::uint16_t low) {
+                    if (open && low == previous + 1) {
+                        previous = low;
+                        return;
+                    }
+                    if (open) {
+                        runs.push_back(static_cast<std::uint16_t>(start));
+                        runs.push_back(static_cast<std::uint16_t>(previous - start));
+                    }
+                    start = previous = low;
+                    open = true;
+                });
+                if (open) {
+                    runs.push_back(static_cast<std::uint16_t>(start));
+                    runs.push_back(static_cast<std::uint16_t>(previous - start));
+                }
+
+                values = std::move(runs);
+                words = std::vector<std::uint64_t>();
+                kind = run_kind;
+            }
+
+            /**
+             * @brief Converts a run container to the array or bitset form that fits its cardinality.
+             */
+            void materialize() {
+                if (kind != run_kind) return;
+                if (cardinality > array_limit) to_bitset();
+                else to_array();
+            }
+
+            /**
+             * @brief Converts a bitset that became small enough back to an array.
+             */
+            void normalize() {
+                if (kind == bitset_kind && cardinality <= array_limit) to_array();
+            }
+
+            std::size_t count_runs() const {
+                switch (kind) {
+                    case run_kind:
+                        return run_count();
+                    case array_kind: {
+                        std::size_t runs = 0;
+                        for (std::size_t i = 0; i < values.size(); ++i) {
+                            if (i == 0 || values[i] != values[i - 1] + 1) ++runs;
+                        }
+                        return runs;
+                    }
+                    default: {
+                        // A run starts at every set bit whose lower neighbor is clear.
+                        std::size_t runs = 0;
+                        std::uint64_t carry = 0;
+                        for (std::size_t i = 0; i < bitset_words; ++i) {
+                            runs += popcount(words[i] & ~((words[i] << 1) | carry));
+                            carry = words[i] >> 63;
+                        }
+                        return runs;
+                    }
+                }
+            }
+
+            /**
+             * @brief Re-encodes the container in its smallest form.
+             */
+            void optimize() {
+                const std::size_t run_bytes = 2 + 4 * count_runs();
+                const std::size_t plain_bytes = cardinality <= array_limit ? 2 * std::size_t{cardinality} : 8192;
+
+                if (run_bytes < plain_bytes) {
+                    if (kind != run_kind) to_runs();
+                } else {
+                    materialize();
+                }
+            }
+
+            std::size_t size_in_bytes() const {
+                return values.size() * sizeof(std::uint16_t) + words.size() * sizeof(std::uint64_t);
+            }
+        };
+
+        std::vector<std::uint16_t> keys; ///< Sorted high 16 bits of every non-empty chunk.
+        std::vector<Container> containers; ///< containers[i] holds the low 16 bits of chunk keys[i].
+
+        static std::uint32_t popcount(const std::uint64_t word) {
+            return static_cast<std::uint32_t>(__builtin_popcountll(word));
+        }
+
+        static void set_range(std::uint64_t *words, const std::uint32_t first, const std::uint32_t last) {
+            const std::size_t first_word = first >> 6;
+            const std::size_t last_word = last >> 6;
+            const std::uint64_t first_mask = ~std::uint64_t{0} << (first & 63);
+            const std::uint64_t last_mask = ~std::uint64_t{0} >> (63 - (last & 63));
+
+            if (first_word == last_word) {
+                words[first_word] |= first_mask & last_mask;
+                return;
+            }
+            words[first_word] |= first_mask;
+            for (std::size_t i = first_word + 1; i < last_word; ++i) words[i] = ~std::uint64_t{0};
+            words[last_word] |= last_mask;
+        }
+
+        template<Op op>
+        static std::uint64_t apply(const std::uint64_t a, const std::uint64_t b) {
+            if constexpr (op == Op::And) return a & b;
+            else if constexpr (op == Op::Or) return a | b;
+            else if constexpr (op == Op::Xor) return a ^ b;
+            else return a & ~b;
+        }
+
+        /**
+         * @brief Combines two bitsets word by word into out and returns the cardinality of the result.
+         */
+        template<Op op>
+        static std::uint32_t combine_bitsets(const std::uint64_t *a, const std::uint64_t *b, std::uint64_t *out) {
+            std::size_t i = 0;
+
+#if defined(__AVX2__)
+            for (; i < bitset_words; i += 4) {
+                const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+                const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+                __m256i result;
+                if constexpr (op == Op::And) result = _mm256_and_si256(x, y);
+                else if constexpr (op == Op::Or) result = _mm256_or_si256(x, y);
+                else if constexpr (op == Op::Xor) result = _mm256_xor_si256(x, y);
+                else result = _mm256_andnot_si256(y, x);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), result);
+            }
+#endif
+
+            for (; i < bitset_words; ++i) out[i] = apply<op>(a[i], b[i]);
+
+            std::uint32_t cardinality = 0;
+            for (std::size_t j = 0; j < bitset_words; ++j) cardinality += popcount(out[j]);
+            return cardinality;
+        }
+
+        /**
+         * @brief Merges two sorted arrays, keeping the values selected by the operation.
+         */
+        template<Op op>
+        static std::vector<std::uint16_t> combine_arrays(const std::vector<std::uint16_t> &a,
+                                                         const std::vector<std::uint16_t> &b) {
+            constexpr bool keep_a_only = op != Op::And;
+            constexpr bool keep_b_only = op == Op::Or || op == Op::Xor;
+            constexpr bool keep_both = op == Op::And || op == Op::Or;
+
+            std::vector<std::uint16_t> out;
+            out.reserve(op == Op::And ? std::min(a.size(), b.size()) : a.size() + (keep_b_only ? b.size() : 0));
+
+            std::size_t i = 0;
+            std::size_t j = 0;
+            while (i < a.size() && j < b.size()) {
+                if (a[i] < b[j]) {
+                    if (keep_a_only) out.push_back(a[i]);
+                    ++i;
+                } else if (b[j] < a[i]) {
+                    if (keep_b_only) out.push_back(b[j]);
+                    ++j;
+                } else {
+                    if (keep_both) out.push_back(a[i]);
+                    ++i;
+                    ++j;
+                }
+            }
+            if (keep_a_only) out.insert(out.end(), a.begin() + static_cast<std::ptrdiff_t>(i), a.end());
+            if (keep_b_only) out.insert(out.end(), b.begin() + static_cast<std::ptrdiff_t>(j), b.end());
+            return out;
+        }
+
+        /**
+         * @brief Intersects a small sorted array with a much larger one by galloping search.
+         */
+        static std::vector<std::uint16_t> intersect_galloping(const std::vector<std::uint16_t> &small,
+                                                              const std::vector<std::uint16_t> &large) {
+            std::vector<std::uint16_t> out;
+            auto from = large.begin();
+
+            for (const std::uint16_t low: small) {
+                std::size_t step = 1;
+                auto bound = from;
+                while (bound != large.end() && *bound < low) {
+                    from = bound;
+                    bound = static_cast<std::size_t>(large.end() - bound) > step
+                                ? bound + static_cast<std::ptrdiff_t>(step)
+                                : large.end();
+                    step *= 2;
+                }
+                from = std::lower_bound(from, bound, low);
+                if (from == large.end()) break;
+                if (*from == low) out.push_back(low);
+            }
+            return out;
+        }
+
+        template<Op op>
+        static Container combine(const Container &left, const Container &right) {
+            // Run containers are expanded first; the result is never run-encoded.
+            Container left_copy;
+            Container right_copy;
+            const Container *a = &left;
+            const Container *b = &right;
+            if (a->kind == Container::run_kind) {
+                left_copy = *a;
+                left_copy.materialize();
+                a = &left_copy;
+            }
+            if (b->kind == Container::run_kind) {
+                right_copy = *b;
+                right_copy.materialize();
+                b = &right_copy;
+            }
+
+            Container out;
+            const bool a_bits = a->kind == Container::bitset_kind;
+            const bool b_bits = b->kind == Container::bitset_kind;
+
+            if (a_bits && b_bits) {
+                out.kind = Container::bitset_kind;
+                out.words.resize(bitset_words);
+                out.cardinality = combine_bitsets<op>(a->words.data(), b->words.data(), out.words.data());
+            } else if (!a_bits && !b_bits) {
+                if constexpr (op == Op::And) {
+                    const bool skewed = a->values.size() * 64 < b->values.size() ||
+                                        b->values.size() * 64 < a->values.size();
+                    if (skewed) {
+                        out.values = a->values.size() < b->values.size()
+                                         ? intersect_galloping(a->values, b->values)
+                                         : intersect_galloping(b->values, a->values);
+                    } else {
+                        out.values = combine_arrays<op>(a->values, b->values);
+                    }
+                } else if (op == Op::Or && a->values.size() + b->values.size() > array_limit) {
+                    out = *a;
+                    out.to_bitset();
+                    for (const std::uint16_t low: b->values) out.words[low >> 6] |= std::uint64_t{1} << (low & 63);
+                    out.cardinality = 0;
+                    for (const std::uint64_t word: out.words) out.cardinality += popcount(word);
+                } else {
+                    out.values = combine_arrays<op>(a->values, b->values);
+                }
+                if (out.kind == Container::array_kind) {
+                    out.cardinality = static_cast<std::uint32_t>(out.values.size());
+                    if (out.cardinality > array_limit) out.to_bitset();
+                }
+            } else if (op == Op::And || (op == Op::AndNot && !a_bits)) {
+                // The result is a subset of an array: filter the array through the bitset.
+                const Container &array = a_bits ? *b : *a;
+                const Container &bits = a_bits ? *a : *b;
+                const bool keep_if_set = op == Op::And;
+                for (const std::uint16_t low: array.values) {
+                    if (static_cast<bool>((bits.words[low >> 6] >> (low & 63)) & 1) == keep_if_set) {
+                        out.values.push_back(low);
+                    }
+                }
+                out.cardinality = static_cast<std::uint32_t>(out.values.size());
+            } else {
+                // Or, Xor, or a bitset minus an array: update a copy of the bitset.
+                const Container &array = a_bits ? *b : *a;
+                out = a_bits ? *a : *b;
+                for (const std::uint16_t low: array.values) {
+                    std::uint64_t &word = out.words[low >> 6];
+                    const std::uint64_t bit = std::uint64_t{1} << (low & 63);
+                    const bool was_set = word & bit;
+                    if constexpr (op == Op::Or) word |= bit;
+                    else if constexpr (op == Op::Xor) word ^= bit;
+                    else word &= ~bit;
+                    out.cardinality += static_cast<std::uint32_t>(static_cast<bool>(word & bit)) - was_set;
+                }
+            }
+
+            out.normalize();
+            return out;
+        }
+
+        template<Op op>
+        static RoaringBitmap combine(const RoaringBitmap &a, const RoaringBitmap &b) {
+            constexpr bool keep_a_only = op != Op::And;
+            constexpr bool keep_b_only = op == Op::Or || op == Op::Xor;
+
+            RoaringBitmap out;
+            std::size_t i = 0;
+            std::size_t j = 0;
+
+            while (i < a.keys.size() || j < b.keys.size()) {
+                if (j == b.keys.size() || (i < a.keys.size() && a.keys[i] < b.keys[j])) {
+                    if (keep_a_only) out.append(a.keys[i], a.containers[i]);
+                    ++i;
+                } else if (i == a.keys.size() || b.keys[j] < a.keys[i]) {
+                    if (keep_b_only) out.append(b.keys[j], b.containers[j]);
+                    ++j;
+                } else {
+                    Container merged = combine<op>(a.containers[i], b.containers[j]);
+                    if (merged.cardinality > 0) out.append(a.keys[i], std::move(merged));
+                    ++i;
+                    ++j;
+                }
+            }
+            return out;
+        }
+
+        void append(const std::uint16_t key, Container container) {
+            keys.push_back(key);
+            containers.push_back(std::move(container));
+        }
+
+        /**
+         * @brief Returns the position of a chunk key, or where it would be inserted.
+         */
+        std::size_t position_of(const std::uint16_t key) const {
+            // Values are often added in increasing order: try the last chunk first.
+            if (!keys.empty() && keys.back() <= key) return keys.back() == key ? keys.size() - 1 : keys.size();
+            return static_cast<std::size_t>(std::lower_bound(keys.begin(), keys.end(), key) - keys.begin());
+        }
+
+        static void write_u16(std::vector<std::uint8_t> &out, const std::uint16_t value) {
+            out.push_back(static_cast<std::uint8_t>(value));
+            out.push_back(static_cast<std::uint8_t>(value >> 8));
+        }
+
+        static std::uint16_t read_u16(const std::uint8_t *in) {
+            return static_cast<std::uint16_t>(in[0] | (in[1] << 8));
+        }
+
+        static void write_u32(std::vector<std::uint8_t> &out, const std::uint32_t value) {
+            for (std::size_t i = 0; i < 4; ++i) out.push_back(static_cast<std::uint8_t>(value >> (i * 8)));
+        }
+
+        static std::uint32_t read_u32(const std::uint8_t *in) {
+            std::uint32_t value = 0;
+            for (std::size_t i = 0; i < 4; ++i) value |= static_cast<std::uint32_t>(in[i]) << (i * 8);
+            return value;
+        }
+
+        static void write_u64(std::vector<std::uint8_t> &out, const std::uint64_t value) {
+            for (std::size_t i = 0; i < 8; ++i) out.push_back(static_cast<std::uint8_t>(value >> (i * 8)));
+        }
+
+        static std::uint64_t read_u64(const std::uint8_t *in) {
+            std::uint64_t value = 0;
+            for (std::size_t i = 0; i < 8; ++i) value |= static_cast<std::uint64_t>(in[i]) << (i * 8);
+            return value;
+        }
+
+    public:
+        /**
+         * @brief A forward iterator over the values of a bitmap, in increasing order.
+         */
+        class Iterator {
+            friend class RoaringBitmap;
+
+            const RoaringBitmap *owner = nullptr;
+            std::size_t chunk = 0;
+            std::size_t position = 0; ///< Array index, bitset word or run index within the chunk.
+            std::uint64_t word = 0; ///< Unvisited bits of the current bitset word.
+            std::uint32_t offset = 0; ///< Offset within the current run.
+            std::uint32_t current = 0;
+
+            Iterator(const RoaringBitmap *owner, const std::size_t chunk) : owner(owner), chunk(chunk) {
+                enter_chunk();
+                settle();
+            }
+
+            void enter_chunk() {
+                position = 0;
+                offset = 0;
+                word = 0;
+                if (chunk < owner->containers.size() && owner->containers[chunk].kind == Container::bitset_kind) {
+                    word = owner->containers[chunk].words[0];
+                }
+            }
+
+            /**
+             * @brief Moves forward to the next value at or after the current position.
+             */
+            void settle() {
+                for (; chunk < owner->containers.size(); ++chunk, enter_chunk()) {
+                    const Container &container = owner->containers[chunk];
+                    const std::uint32_t high = static_cast<std::uint32_t>(owner->keys[chunk]) << 16;
+
+                    switch (container.kind) {
+                        case Container::array_kind:
+                            if (position < container.values.size()) {
+                                current = high | container.values[position];
+                                return;
+                            }
+                            break;
+                        case Container::bitset_kind:
+                            while (word == 0 && ++position < bitset_words) word = container.words[position];
+                            if (word != 0) {
+                                current = high | static_cast<std::uint32_t>(position * 64 + __builtin_ctzll(word));
+                                return;
+                            }
+                            break;
+                        default:
+                            if (position < container.run_count()) {
+                                current = high | (container.run_start(position) + offset);
+                                return;
+                            }
+                    }
+                }
+            }
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::uint32_t;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const std::uint32_t *;
+            using reference = const std::uint32_t &;
+
+            Iterator() = default;
+
+            reference operator*() const {
+                return current;
+            }
+
+            Iterator &operator++() {
+                const Container &container = owner->containers[chunk];
+                switch (container.kind) {
+                    case Container::array_kind:
+                        ++position;
+                        break;
+                    case Container::bitset_kind:
+                        word &= word - 1;
+                        break;
+                    default:
+                        if (container.run_start(position) + offset < container.run_end(position)) {
+                            ++offset;
+                        } else {
+                            ++position;
+                            offset = 0;
+                        }
+                }
+                settle();
+                return *this;
+            }
+
+            Iterator operator++(int) {
+                Iterator copy = *this;
+                ++*this;
+                return copy;
+            }
+
+            bool operator==(const Iterator &other) const {
+                return chunk == other.chunk && position == other.position && word == other.word &&
+                       offset == other.offset;
+            }
+
+            bool operator!=(const Iterator &other) const {
+                return !(*this == other);
+            }
+        };
+
+        RoaringBitmap() = default;
+
+        /**
+         * @brief Builds a bitmap from the values of a DS::Array, in any order.
+         * @param array The values.
+         */
+        explicit RoaringBitmap(const Array<std::uint32_t> &array) {
+            for (int i = 0; i < array.size(); ++i) add(array.at(i));
+        }
+
+        /**
+         * @brief Adds a value.
+         * @return true if the value was added, false if it was already present.
+         */
+        bool add(const std::uint32_t value) {
+            const auto key = static_cast<std::uint16_t>(value >> 16);
+            const std::size_t position = position_of(key);
+
+            if (position == keys.size() || keys[position] != key) {
+                keys.insert(keys.begin() + static_cast<std::ptrdiff_t>(position), key);
+                containers.insert(containers.begin() + static_cast<std::ptrdiff_t>(position), Container());
+            }
+            return containers[position].add(static_cast<std::uint16_t>(value));
+        }
+
+        /**
+         * @brief Adds every value in [first, last].
+         *
+         * Chunks that did not exist yet and chunks that become runs are stored as run
+         * containers, so adding a long range costs a few bytes per chunk.
+         */
+        void add_range(const std::uint32_t first, const std::uint32_t last) {
+            if (first > last) return;
+
+            for (std::uint32_t key = first >> 16; key <= last >> 16; ++key) {
+                const std::uint32_t low_first = key == first >> 16 ? first & 0xFFFF : 0;
+                const std::uint32_t low_last = key == last >> 16 ? last & 0xFFFF : 0xFFFF;
+
+                Container range;
+                range.kind = Container::run_kind;
+                range.cardinality = low_last - low_first + 1;
+                range.values = {static_cast<std::uint16_t>(low_first), static_cast<std::uint16_t>(low_last - low_first)};
+
+                const auto high = static_cast<std::uint16_t>(key);
+                const std::size_t position = position_of(high);
+                if (position == keys.size() || keys[position] != high) {
+                    keys.insert(keys.begin() + static_cast<std::ptrdiff_t>(position), high);
+                    containers.insert(containers.begin() + static_cast<std::ptrdiff_t>(position), std::move(range));
+                } else {
+                    containers[position] = combine<Op::Or>(containers[position], range);
+                    containers[position].optimize();
+                }
+            }
+        }
+
+        /**
+         * @brief Removes a value.
+         * @return true if the value was removed, false if it was not present.
+         */
+        bool remove(const std::uint32_t value) {
+            const auto key = static_cast<std::uint16_t>(value >> 16);
+            const std::size_t position = position_of(key);
+            if (position == keys.size() || keys[position] != key) return false;
+            if (!containers[position].remove(static_cast<std::uint16_t>(value))) return false;
+
+            if (containers[position].cardinality == 0) {
+                keys.erase(keys.begin() + static_cast<std::ptrdiff_t>(position));
+                containers.erase(containers.begin() + static_cast<std::ptrdiff_t>(position));
+            }
+            return true;
+        }
+
+        bool contains(const std::uint32_t value) const {
+            const auto key = static_cast<std::uint16_t>(value >> 16);
+            const std::size_t position = position_of(key);
+            return position < keys.size() && keys[position] == key &&
+                   containers[position].contains(static_cast<std::uint16_t>(value));
+        }
+
+        /**
+         * @brief Returns the number of values that are less than or equal to a value.
+         */
+        std::uint64_t rank(const std::uint32_t value) const {
+            const auto key = static_cast<std::uint16_t>(value >> 16);
+            std::uint64_t count = 0;
+
+            for (std::size_t i = 0; i < keys.size() && keys[i] <= key; ++i) {
+                count += keys[i] < key ? containers[i].cardinality
+                                       : containers[i].rank(static_cast<std::uint16_t>(value));
+            }
+            return count;
+        }
+
+        /**
+         * @brief Returns the number of values.
+         */
+        std::uint64_t cardinality() const {
+            std::uint64_t count = 0;
+            for (const Container &container: containers) count += container.cardinality;
+            return count;
+        }
+
+        bool empty() const noexcept {
+            return keys.empty();
+        }
+
+        void clear() {
+            keys.clear();
+            containers.clear();
+        }
+
+        /**
+         * @brief Re-encodes every chunk in its smallest form, turning long runs into run containers.
+         */
+        void run_optimize() {
+            for (Container &container: containers) container.optimize();
+        }
+
+        /**
+         * @brief Returns the number of bytes used by the containers' payloads.
+         */
+        std::size_t size_in_bytes() const {
+            std::size_t bytes = keys.size() * sizeof(std::uint16_t);
+            for (const Container &container: containers) bytes += container.size_in_bytes();
+            return bytes;
+        }
+
+        /**
+         * @brief Calls fn(value) for every value, in increasing order.
+         */
+        template<typename Fn>
+        void for_each(Fn fn) const {
+            for (std::size_t i = 0; i < keys.size(); ++i) {
+                const std::uint32_t high = static_cast<std::uint32_t>(keys[i]) << 16;
+                containers[i].for_each([&fn, high](const std::uint16_t low) { fn(high | low); });
+            }
+        }
+
+        Iterator begin() const {
+            return Iterator(this, 0);
+        }
+
+        Iterator end() const {
+            return Iterator(this, containers.size());
+        }
+
+        RoaringBitmap operator&(const RoaringBitmap &other) const {
+            return combine<Op::And>(*this, other);
+        }
+
+        RoaringBitmap operator|(const RoaringBitmap &other) const {
+            return combine<Op::Or>(*this, other);
+        }
+
+        RoaringBitmap operator^(const RoaringBitmap &other) const {
+            return combine<Op::Xor>(*this, other);
+        }
+
+        /**
+         * @brief Returns the values of this bitmap that are not in the other (and-not).
+         */
+        RoaringBitmap operator-(const RoaringBitmap &other) const {
+            return combine<Op::AndNot>(*this, other);
+        }
+
+        RoaringBitmap &operator&=(const RoaringBitmap &other) {
+            return *this = *this & other;
+        }
+
+        RoaringBitmap &operator|=(const RoaringBitmap &other) {
+            return *this = *this | other;
+        }
+
+        RoaringBitmap &operator^=(const RoaringBitmap &other) {
+            return *this = *this ^ other;
+        }
+
+        RoaringBitmap &operator-=(const RoaringBitmap &other) {
+            return *this = *this - other;
+        }
+
+        /**
+         * @brief Checks whether two bitmaps hold the same values, whatever their container forms.
+         */
+        bool operator==(const RoaringBitmap &other) const {
+            if (keys != other.keys) return false;
+            for (std::size_t i = 0; i < keys.size(); ++i) {
+                if (containers[i].cardinality != other.containers[i].cardinality) return false;
+            }
+            return std::equal(begin(), end(), other.begin());
+        }
+
+        bool operator!=(const RoaringBitmap &other) const {
+            return !(*this == other);
+        }
+
+        /**
+         * @brief Serializes the bitmap to a portable little-endian byte string.
+         *
+         * Layout: "DSRB", u32 format version, u32 chunk count, then per chunk a u16 key,
+         * a u8 kind (0 array, 1 bitset, 2 run), a u32 count (values for arrays and bitsets,
+         * runs for run containers) and the payload: u16 values, 1024 u64 words, or u16
+         * (start, length - 1) pairs.
+         *
+         * @return The serialized bitmap.
+         */
+        std::vector<std::uint8_t> serialize() const {
+            std::vector<std::uint8_t> out;
+            out.reserve(12 + 7 * keys.size() + size_in_bytes());
+            for (const char c: magic) out.push_back(static_cast<std::uint8_t>(c));
+            write_u32(out, format_version);
+            write_u32(out, static_cast<std::uint32_t>(keys.size()));
+
+            for (std::size_t i = 0; i < keys.size(); ++i) {
+                const Container &container = containers[i];
+                write_u16(out, keys[i]);
+                out.push_back(container.kind);
+                write_u32(out, container.kind == Container::run_kind
+                                   ? static_cast<std::uint32_t>(container.run_count())
+                                   : container.cardinality);
+
+                for (const std::uint16_t value: container.values) write_u16(out, value);
+                for (const std::uint64_t word: container.words) write_u64(out, word);
+            }
+
+            return out;
+        }
+
+        /**
+         * @brief Rebuilds a bitmap from the output of serialize().
+         * @param bytes The serialized bitmap.
+         * @return The bitmap.
+         * @throws std::runtime_error If the bytes are not a valid serialized bitmap.
+         */
+        static RoaringBitmap deserialize(const std::vector<std::uint8_t> &bytes) {
+            if (bytes.size() < 12 || std::memcmp(bytes.data(), magic, 4) != 0) {
+                throw std::runtime_error("Invalid Roaring bitmap data");
+            }
+            if (read_u32(bytes.data() + 4) != format_version) {
+                throw std::runtime_error("Unsupported Roaring bitmap version");
+            }
+
+            const std::uint32_t chunks = read_u32(bytes.data() + 8);
+            if (chunks > 65536) throw std::runtime_error("Invalid Roaring bitmap data");
+
+            RoaringBitmap bitmap;
+            std::size_t at = 12;
+            const auto need = [&bytes, &at](const std::size_t count) {
+                if (bytes.size() - at < count) throw std::runtime_error("Invalid Roaring bitmap data");
+            };
+
+            for (std::uint32_t chunk = 0; chunk < chunks; ++chunk) {
+                need(7);
+                const std::uint16_t key = read_u16(bytes.data() + at);
+                const std::uint8_t kind = bytes[at + 2];
+                const std::uint32_t count = read_u32(bytes.data() + at + 3);
+                at += 7;
+
+                if (kind > Container::run_kind || (!bitmap.keys.empty() && key <= bitmap.keys.back())) {
+                    throw std::runtime_error("Invalid Roaring bitmap data");
+                }
+
+                Container container;
+                container.kind = static_cast<Container::Kind>(kind);
+
+                if (kind == Container::array_kind) {
+                    if (count == 0 || count > array_limit) throw std::runtime_error("Invalid Roaring bitmap data");
+                    need(2 * std::size_t{count});
+                    container.values.resize(count);
+                    for (std::uint32_t i = 0; i < count; ++i) {
+                        container.values[i] = read_u16(bytes.data() + at + 2 * i);
+                        if (i > 0 && container.values[i] <= container.values[i - 1]) {
+                            throw std::runtime_error("Invalid Roaring bitmap data");
+                        }
+                    }
+                    container.cardinality = count;
+                    at += 2 * std::size_t{count};
+                } else if (kind == Container::bitset_kind) {
+                    need(8 * bitset_words);
+                    container.words.resize(bitset_words);
+                    for (std::size_t i = 0; i < bitset_words; ++i) {
+                        container.words[i] = read_u64(bytes.data() + at + 8 * i);
+                        container.cardinality += popcount(container.words[i]);
+                    }
+                    if (container.cardinality != count || count == 0) {
+                        throw std::runtime_error("Invalid Roaring bitmap data");
+                    }
+                    at += 8 * bitset_words;
+                } else {
+                    if (count == 0 || count > 32768) throw std::runtime_error("Invalid Roaring bitmap data");
+                    need(4 * std::size_t{count});
+                    container.values.resize(2 * std::size_t{count});
+                    for (std::size_t i = 0; i < container.values.size(); ++i) {
+                        container.values[i] = read_u16(bytes.data() + at + 2 * i);
+                    }
+                    for (std::size_t run = 0; run < count; ++run) {
+                        // Runs must be sorted, disjoint and non-adjacent, and end inside the chunk.
+                        if (container.run_end(run) > 0xFFFF ||
+                            (run > 0 && container.run_start(run) <= container.run_end(run - 1) + 1)) {
+                            throw std::runtime_error("Invalid Roaring bitmap data");
+                        }
+                        container.cardinality += container.run_end(run) - container.run_start(run) + 1;
+                    }
+                    at += 4 * std::size_t{count};
+                }
+
+                bitmap.append(key, std::move(container));
+            }
+
+            if (at != bytes.size()) throw std::runtime_error("Invalid Roaring bitmap data");
+            return bitmap;
+        }
+
+        void show() const {
+            std::cout << "{";
+
+            bool first = true;
+            for_each([&first](const std::uint32_t value) {
+                if (!first) std::cout << ", ";
+                std::cout << value;
+                first = false;
+            });
+
+            std::cout << "}\n";
+        }
+    };
+} // DS
+
+#endif //ROARINGBITMAP_H
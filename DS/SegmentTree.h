@@ -0,0 +1,424 @@
+#ifndef SEGMENTTREE_H
+#define SEGMENTTREE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "Array.h"
+
+namespace DS {
+    /**
+     * @brief Monoid of sums, for use with SegmentTree and LazySegmentTree.
+     *
+     * A monoid policy defines value_type, an identity() element and an associative
+     * combine(); combine does not need to be commutative.
+     */
+    template<typename T>
+    struct SumMonoid {
+        using value_type = T;
+
+        static T identity() {
+            return T();
+        }
+
+        static T combine(const T &a, const T &b) {
+            return a + b;
+        }
+    };
+
+    /**
+     * @brief Monoid of minimums, for use with SegmentTree and LazySegmentTree.
+     */
+    template<typename T>
+    struct MinMonoid {
+        using value_type = T;
+
+        static T identity() {
+            return std::numeric_limits<T>::max();
+        }
+
+        static T combine(const T &a, const T &b) {
+            return std::min(a, b);
+        }
+    };
+
+    /**
+     * @brief Monoid of maximums, for use with SegmentTree and LazySegmentTree.
+     */
+    template<typename T>
+    struct MaxMonoid {
+        using value_type = T;
+
+        static T identity() {
+            return std::numeric_limits<T>::lowest();
+        }
+
+        static T combine(const T &a, const T &b) {
+            return std::max(a, b);
+        }
+    };
+
+    /**
+     * @brief Range-add action on a SumMonoid, for use with LazySegmentTree.
+     *
+     * An action policy defines update_type, an identity() update, compose(newer, older)
+     * that merges two pending updates, and apply(update, value, length) that applies an
+     * update to the combined value of a segment of the given number of elements.
+     */
+    template<typename T>
+    struct AddToSum {
+        using update_type = T;
+
+        static T identity() {
+            return T();
+        }
+
+        static T compose(const T &newer, const T &older) {
+            return newer + older;
+        }
+
+        static T apply(const T &update, const T &value, const std::size_t length) {
+            return value + update * static_cast<T>(length);
+        }
+    };
+
+    /**
+     * @brief Range-add action on a MinMonoid or MaxMonoid, for use with LazySegmentTree.
+     *
+     * Adding to every element shifts the minimum and maximum by the same amount.
+     * LazySegmentTree never applies an update to a segment without elements, so the
+     * monoid identity of the padding is never shifted.
+     */
+    template<typename T>
+    struct AddToExtremum {
+        using update_type = T;
+
+        static T identity() {
+            return T();
+        }
+
+        static T compose(const T &newer, const T &older) {
+            return newer + older;
+        }
+
+        static T apply(const T &update, const T &value, std::size_t) {
+            return value + update;
+        }
+    };
+
+    /**
+     * @brief An iterative bottom-up segment tree with point updates and range queries.
+     *
+     * The n leaves live at [n, 2n) of one flat array and every internal node i combines
+     * nodes 2i and 2i + 1. Queries and updates walk up from the leaves without recursion,
+     * in O(log n). Building from existing values takes O(n).
+     *
+     * @tparam Monoid A monoid policy such as SumMonoid, MinMonoid or MaxMonoid.
+     */
+    template<typename Monoid>
+    class SegmentTree {
+        using T = typename Monoid::value_type;
+
+        std::size_t n;
+        std::vector<T> tree;
+
+        void build() {
+            for (std::size_t i = n; i-- > 1;) {
+                tree[i] = Monoid::combine(tree[2 * i], tree[2 * i + 1]);
+            }
+        }
+
+    public:
+        /**
+         * @brief Constructs a tree of n identity elements.
+         * @param n The number of elements.
+         */
+        explicit SegmentTree(const std::size_t n = 0) : n(n), tree(2 * n, Monoid::identity()) {}
+
+        /**
+         * @brief Builds a tree from a DS::Array in O(n).
+         * @param array The initial elements.
+         */
+        explicit SegmentTree(const Array<T> &array)
+            : n(static_cast<std::size_t>(array.size())), tree(2 * n, Monoid::identity()) {
+            for (std::size_t i = 0; i < n; ++i) tree[n + i] = array.at(static_cast<int>(i));
+            build();
+        }
+
+        /**
+         * @brief Builds a tree from a plain array in O(n).
+         * @param values Pointer to the first element.
+         * @param n The number of elements.
+         */
+        SegmentTree(const T *values, const std::size_t n) : n(n), tree(2 * n, Monoid::identity()) {
+            std::copy(values, values + n, tree.begin() + static_cast<std::ptrdiff_t>(n));
+            build();
+        }
+
+        std::size_t size() const noexcept {
+            return n;
+        }
+
+        bool empty() const noexcept {
+            return n == 0;
+        }
+
+        /**
+         * @brief Replaces the element at an index.
+         * @param index The index of the element (0-indexed).
+         * @param value The new value.
+         * @throws std::out_of_range If the index is out of bounds.
+         */
+        void set(std::size_t index, const T &value) {
+            if (index >= n) throw std::out_of_range("Index out of bounds");
+
+            index += n;
+            tree[index] = value;
+            for (index /= 2; index > 0; index /= 2) {
+                tree[index] = Monoid::combine(tree[2 * index], tree[2 * index + 1]);
+            }
+        }
+
+        /**
+         * @brief Returns the element at an index.
+         * @param index The index of the element (0-indexed).
+         * @throws std::out_of_range If the index is out of bounds.
+         */
+        T get(const std::size_t index) const {
+            if (index >= n) throw std::out_of_range("Index out of bounds");
+            return tree[n + index];
+        }
+
+        /**
+         * @brief Combines the elements in [begin, end), in order.
+         * @param begin The inclusive start index.
+         * @param end The exclusive end index.
+         * @return The combined value, or the identity if the range is empty.
+         * @throws std::out_of_range If the range is invalid.
+         */
+        T query(std::size_t begin, std::size_t end) const {
+            if (begin > end || end > n) throw std::out_of_range("Invalid range");
+
+            // Separate accumulators keep the order of a non-commutative combine.
+            T left = Monoid::identity();
+            T right = Monoid::identity();
+
+            for (begin += n, end += n; begin < end; begin /= 2, end /= 2) {
+                if (begin & 1) left = Monoid::combine(left, tree[begin++]);
+                if (end & 1) right = Monoid::combine(tree[--end], right);
+            }
+
+            return Monoid::combine(left, right);
+        }
+
+        /**
+         * @brief Combines every element.
+         */
+        T query_all() const {
+            return query(0, n);
+        }
+    };
+
+    /**
+     * @brief An iterative segment tree with range updates, range queries and lazy propagation.
+     *
+     * The tree is a perfect binary tree over a power-of-two number of leaves, stored in one
+     * flat array with a second flat array of pending updates for the internal nodes. Both
+     * apply() and query() push pending updates down the two boundary paths, work bottom-up
+     * without recursion, and run in O(log n).
+     *
+     * @tparam Monoid A monoid policy such as SumMonoid, MinMonoid or MaxMonoid.
+     * @tparam Action An action policy such as AddToSum or AddToExtremum.
+     */
+    template<typename Monoid, typename Action>
+    class LazySegmentTree {
+        using T = typename Monoid::value_type;
+        using U = typename Action::update_type;
+
+        std::size_t n;
+        std::size_t height; ///< log2 of the number of leaves.
+        std::size_t leaves; ///< Number of leaves, the smallest power of two >= n.
+        std::vector<T> tree;
+        std::vector<U> pending; ///< Update to apply to the children of each internal node.
+
+        /**
+         * @brief Returns the number of real elements under a node, leaving out the padding leaves past n.
+         */
+        std::size_t length(const std::size_t node) const {
+            const auto depth = static_cast<std::size_t>(63 - __builtin_clzll(node));
+            const std::size_t span = leaves >> depth;
+            const std::size_t first = node * span - leaves;
+            return first >= n ? 0 : std::min(span, n - first);
+        }
+
+        void pull(const std::size_t node) {
+            tree[node] = Monoid::combine(tree[2 * node], tree[2 * node + 1]);
+        }
+
+        void apply_to_node(const std::size_t node, const U &update) {
+            // Nodes made only of padding keep the identity.
+            const std::size_t node_length = length(node);
+            if (node_length == 0) return;
+            tree[node] = Action::apply(update, tree[node], node_length);
+            if (node < leaves) pending[node] = Action::compose(update, pending[node]);
+        }
+
+        void push(const std::size_t node) {
+            apply_to_node(2 * node, pending[node]);
+            apply_to_node(2 * node + 1, pending[node]);
+            pending[node] = Action::identity();
+        }
+
+        /**
+         * @brief Pushes pending updates down to the boundaries of [begin, end), given as leaf positions.
+         */
+        void push_boundaries(const std::size_t begin, const std::size_t end) {
+            for (std::size_t i = height; i >= 1; --i) {
+                if (((begin >> i) << i) != begin) push(begin >> i);
+                if (((end >> i) << i) != end) push((end - 1) >> i);
+            }
+        }
+
+        void init() {
+            height = 0;
+            while ((std::size_t{1} << height) < n) ++height;
+            leaves = std::size_t{1} << height;
+            tree.assign(2 * leaves, Monoid::identity());
+            pending.assign(leaves, Action::identity());
+        }
+
+        void build() {
+            for (std::size_t i = leaves - 1; i > 0; --i) pull(i);
+        }
+
+    public:
+        /**
+         * @brief Constructs a tree of n identity elements.
+         * @param n The number of elements.
+         */
+        explicit LazySegmentTree(const std::size_t n = 0) : n(n) {
+            init();
+        }
+
+        /**
+         * @brief Builds a tree from a DS::Array in O(n).
+         * @param array The initial elements.
+         */
+        explicit LazySegmentTree(const Array<T> &array) : n(static_cast<std::size_t>(array.size())) {
+            init();
+            for (std::size_t i = 0; i < n; ++i) tree[leaves + i] = array.at(static_cast<int>(i));
+            build();
+        }
+
+        /**
+         * @brief Builds a tree from a plain array in O(n).
+         * @param values Pointer to the first element.
+         * @param n The number of elements.
+         */
+        LazySegmentTree(const T *values, const std::size_t n) : n(n) {
+            init();
+            std::copy(values, values + n, tree.begin() + static_cast<std::ptrdiff_t>(leaves));
+            build();
+        }
+
+        std::size_t size() const noexcept {
+            return n;
+        }
+
+        bool empty() const noexcept {
+            return n == 0;
+        }
+
+        /**
+         * @brief Replaces the element at an index.
+         * @param index The index of the element (0-indexed).
+         * @param value The new value.
+         * @throws std::out_of_range If the index is out of bounds.
+         */
+        void set(std::size_t index, const T &value) {
+            if (index >= n) throw std::out_of_range("Index out of bounds");
+
+            index += leaves;
+            for (std::size_t i = height; i >= 1; --i) push(index >> i);
+            tree[index] = value;
+            for (std::size_t i = 1; i <= height; ++i) pull(index >> i);
+        }
+
+        /**
+         * @brief Returns the element at an index.
+         * @param index The index of the element (0-indexed).
+         * @throws std::out_of_range If the index is out of bounds.
+         */
+        T get(std::size_t index) {
+            if (index >= n) throw std::out_of_range("Index out of bounds");
+
+            index += leaves;
+            for (std::size_t i = height; i >= 1; --i) push(index >> i);
+            return tree[index];
+        }
+
+        /**
+         * @brief Combines the elements in [begin, end), in order.
+         * @param begin The inclusive start index.
+         * @param end The exclusive end index.
+         * @return The combined value, or the identity if the range is empty.
+         * @throws std::out_of_range If the range is invalid.
+         */
+        T query(std::size_t begin, std::size_t end) {
+            if (begin > end || end > n) throw std::out_of_range("Invalid range");
+            if (begin == end) return Monoid::identity();
+
+            begin += leaves;
+            end += leaves;
+            push_boundaries(begin, end);
+
+            T left = Monoid::identity();
+            T right = Monoid::identity();
+
+            for (; begin < end; begin /= 2, end /= 2) {
+                if (begin & 1) left = Monoid::combine(left, tree[begin++]);
+                if (end & 1) right = Monoid::combine(tree[--end], right);
+            }
+
+            return Monoid::combine(left, right);
+        }
+
+        /**
+         * @brief Combines every element.
+         */
+        T query_all() const {
+            return tree[1];
+        }
+
+        /**
+         * @brief Applies an update to every element in [begin, end).
+         * @param begin The inclusive start index.
+         * @param end The exclusive end index.
+         * @param update The update to apply.
+         * @throws std::out_of_range If the range is invalid.
+         */
+        void apply(std::size_t begin, std::size_t end, const U &update) {
+            if (begin > end || end > n) throw std::out_of_range("Invalid range");
+            if (begin == end) return;
+
+            begin += leaves;
+            end += leaves;
+            push_boundaries(begin, end);
+
+            for (std::size_t l = begin, r = end; l < r; l /= 2, r /= 2) {
+                if (l & 1) apply_to_node(l++, update);
+                if (r & 1) apply_to_node(--r, update);
+            }
+
+            for (std::size_t i = 1; i <= height; ++i) {
+                if (((begin >> i) << i) != begin) pull(begin >> i);
+                if (((end >> i) << i) != end) pull((end - 1) >> i);
+            }
+        }
+    };
+} // DS
+
+#endif //SEGMENTTREE_H
@@ -0,0 +1,121 @@
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace DS {
+    /**
+     * @brief A sequence lock for data that is read far more often than it is written.
+     *
+     * Writers make the sequence odd while they modify the protected data and even again
+     * when they are done. Readers never write to the lock: they remember the sequence,
+     * copy the data, and retry if the sequence moved in the meantime.
+     *
+     * Typical reader loop:
+     * @code
+     * std::uint64_t start;
+     * do {
+     *     start = lock.read_begin();
+     *     copy = data;
+     * } while (lock.read_retry(start));
+     * @endcode
+     *
+     * @note The data read inside the loop may be torn, so it must be trivially copyable
+     *       and must not be used before read_retry() returns false.
+     */
+    class SeqLock {
+        std::atomic<std::uint64_t> sequence{0}; ///< Odd while a writer is active.
+
+    public:
+        /**
+         * @brief Constructs an unlocked sequence lock.
+         */
+        SeqLock() = default;
+
+        SeqLock(const SeqLock &) = delete;
+
+        SeqLock &operator=(const SeqLock &) = delete;
+
+        /**
+         * @brief Starts an optimistic read.
+         *
+         * Waits until no writer is active.
+         *
+         * @return The sequence number to pass to read_retry().
+         */
+        std::uint64_t read_begin() const noexcept {
+            std::uint64_t start = sequence.load(std::memory_order_acquire);
+            while (start & 1) {
+                std::this_thread::yield();
+                start = sequence.load(std::memory_order_acquire);
+            }
+            return start;
+        }
+
+        /**
+         * @brief Checks whether an optimistic read has to be repeated.
+         *
+         * @param start The value returned by the matching read_begin().
+         * @return true if a writer ran during the read, false if the copy is consistent.
+         */
+        bool read_retry(const std::uint64_t start) const noexcept {
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return sequence.load(std::memory_order_relaxed) != start;
+        }
+
+        /**
+         * @brief Marks the start of a write.
+         *
+         * The caller must already exclude other writers (for example with a mutex).
+         * Use lock() when the sequence lock itself should provide that exclusion.
+         */
+        void write_begin() noexcept {
+            sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+
+        /**
+         * @brief Marks the end of a write started with write_begin().
+         */
+        void write_end() noexcept {
+            sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        /**
+         * @brief Acquires the lock for writing, spinning while another writer holds it.
+         */
+        void lock() noexcept {
+            std::uint64_t current = sequence.load(std::memory_order_relaxed);
+            for (;;) {
+                if (!(current & 1) &&
+                    sequence.compare_exchange_weak(current, current + 1, std::memory_order_acquire,
+                                                   std::memory_order_relaxed)) {
+                    break;
+                }
+                std::this_thread::yield();
+                current = sequence.load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+
+        /**
+         * @brief Releases the lock acquired with lock().
+         */
+        void unlock() noexcept {
+            write_end();
+        }
+
+        /**
+         * @brief Returns the current sequence number.
+         *
+         * @return The sequence number; odd while a write is in progress.
+         */
+        std::uint64_t version() const noexcept {
+            return sequence.load(std::memory_order_acquire);
+        }
+    };
+} // DS
+
+#endif //SEQLOCK_H
@@ -0,0 +1,159 @@
+#ifndef SEQLOCKARRAY_H
+#define SEQLOCKARRAY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "Array.h"
+#include "SeqLock.h"
+
+namespace DS {
+    /**
+     * @brief A fixed-size array for values that are read far more often than written, protected by a SeqLock.
+     *
+     * Readers copy the values optimistically and retry if a writer ran meanwhile, so they
+     * never write to shared memory and never wait for each other. Writers serialize on
+     * the lock and bump its sequence around every update, so an update of several values
+     * is seen by readers either entirely or not at all.
+     *
+     * @tparam T The type of the values. Must be trivially copyable, since readers may copy
+     *           a value while it is being written and discard the copy afterwards.
+     */
+    template<typename T>
+    class SeqLockArray {
+        static_assert(std::is_trivially_copyable<T>::value, "SeqLockArray requires a trivially copyable type");
+
+        SeqLock lock;
+        std::size_t n;
+        std::unique_ptr<T[]> values;
+
+        void check(const std::size_t index) const {
+            if (index >= n) throw std::out_of_range("Index out of bounds");
+        }
+
+    public:
+        /**
+         * @brief Constructs an array of copies of a value.
+         *
+         * @param size The number of values.
+         * @param value The initial value.
+         */
+        explicit SeqLockArray(const std::size_t size, const T &value = T()) : n(size), values(new T[size]) {
+            for (std::size_t i = 0; i < n; ++i) values[i] = value;
+        }
+
+        /**
+         * @brief Constructs an array holding the values of a DS::Array.
+         *
+         * @param array The values.
+         */
+        explicit SeqLockArray(const Array<T> &array)
+            : n(static_cast<std::size_t>(array.size())), values(new T[static_cast<std::size_t>(array.size())]) {
+            for (int i = 0; i < array.size(); ++i) values[i] = array.at(i);
+        }
+
+        SeqLockArray(const SeqLockArray &) = delete;
+
+        SeqLockArray &operator=(const SeqLockArray &) = delete;
+
+        std::size_t size() const noexcept {
+            return n;
+        }
+
+        /**
+         * @brief Reads one value.
+         *
+         * @param index The index of the value.
+         * @return A consistent copy of the value.
+         * @throws std::out_of_range If the index is out of bounds.
+         */
+        T load(const std::size_t index) const {
+            check(index);
+            T value;
+            std::uint64_t start;
+            do {
+                start = lock.read_begin();
+                std::memcpy(&value, &values[index], sizeof(T));
+            } while (lock.read_retry(start));
+            return value;
+        }
+
+        /**
+         * @brief Copies all values as of a single point in time.
+         *
+         * @param out Receives size() values.
+         */
+        void snapshot(T *out) const {
+            std::uint64_t start;
+            do {
+                start = lock.read_begin();
+                std::memcpy(out, values.get(), n * sizeof(T));
+            } while (lock.read_retry(start));
+        }
+
+        /**
+         * @brief Appends a consistent copy of all values to a DS::Array.
+         *
+         * @param array The array to append to.
+         */
+        void append_to(Array<T> &array) const {
+            std::vector<T> copy(n);
+            snapshot(copy.data());
+            for (const T &value: copy) array.push_back(value);
+        }
+
+        /**
+         * @brief Writes one value.
+         *
+         * @param index The index of the value.
+         * @param value The new value.
+         * @throws std::out_of_range If the index is out of bounds.
+         */
+        void store(const std::size_t index, const T &value) {
+            check(index);
+            lock.lock();
+            values[index] = value;
+            lock.unlock();
+        }
+
+        /**
+         * @brief Replaces all values at once.
+         *
+         * @param source size() new values.
+         */
+        void assign(const T *source) {
+            lock.lock();
+            std::memcpy(values.get(), source, n * sizeof(T));
+            lock.unlock();
+        }
+
+        /**
+         * @brief Applies several changes that readers see all together.
+         *
+         * fn(data, size) runs with the writer lock held; it must not throw and should be
+         * short, since readers retry until it returns.
+         *
+         * @param fn The function that modifies the values in place.
+         */
+        template<typename Fn>
+        void update(Fn fn) {
+            lock.lock();
+            fn(values.get(), n);
+            lock.unlock();
+        }
+
+        /**
+         * @brief Returns the sequence number of the lock; it changes with every update.
+         */
+        std::uint64_t version() const noexcept {
+            return lock.version();
+        }
+    };
+} // DS
+
+#endif //SEQLOCKARRAY_H
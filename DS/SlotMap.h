@@ -0,0 +1,282 @@
+#ifndef SLOTMAP_H
+#define SLOTMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace DS {
+    /**
+     * @brief A container of values addressed by stable, generation-tagged handles.
+     *
+     * Values live contiguously in a dense array, so iteration runs at array speed. Each
+     * handle names a slot in a sparse array, which stores the position of its value in
+     * the dense array and a generation counter. Erasing a value moves the last dense
+     * value into the hole (swap-and-pop) and bumps the slot's generation, so:
+     *  - insert, erase and lookup by handle are O(1);
+     *  - handles of other values stay valid across erasures;
+     *  - a handle to an erased value is detected as stale, even after its slot is reused.
+     *
+     * Erasing reorders the dense array; use handle_at() to map a dense position back to
+     * its handle while iterating.
+     *
+     * @tparam T The type of the values.
+     */
+    template<typename T>
+    class SlotMap {
+    public:
+        /**
+         * @brief An opaque reference to a value in a SlotMap.
+         *
+         * A default-constructed handle never refers to a value.
+         */
+        struct Handle {
+            std::uint32_t index = std::numeric_limits<std::uint32_t>::max(); ///< Slot in the sparse array.
+            std::uint32_t generation = 0; ///< Generation of the slot when the value was inserted.
+
+            bool operator==(const Handle &other) const {
+                return index == other.index && generation == other.generation;
+            }
+
+            bool operator!=(const Handle &other) const {
+                return !(*this == other);
+            }
+        };
+
+    private:
+        static constexpr std::uint32_t none = std::numeric_limits<std::uint32_t>::max();
+
+        struct Slot {
+            std::uint32_t target; ///< Dense position if occupied, otherwise the next free slot.
+            std::uint32_t generation;
+        };
+
+        std::vector<T> values;
+        std::vector<std::uint32_t> owners; ///< owners[i] is the slot of values[i].
+        std::vector<Slot> slots;
+        std::uint32_t free_head = none;
+
+        bool occupied(const Handle handle) const {
+            // Releasing a slot bumps its generation, so only the live value's handle can match.
+            return handle.index < slots.size() && slots[handle.index].generation == handle.generation;
+        }
+
+        /**
+         * @brief Assigns a slot to the value just appended to the dense array.
+         */
+        Handle acquire_slot() {
+            if (values.size() >= none) throw std::runtime_error("SlotMap is full");
+
+            const auto position = static_cast<std::uint32_t>(values.size() - 1);
+            std::uint32_t index;
+
+            if (free_head != none) {
+                index = free_head;
+                free_head = slots[index].target;
+                slots[index].target = position;
+            } else {
+                if (slots.size() >= none) throw std::runtime_error("SlotMap is full");
+                index = static_cast<std::uint32_t>(slots.size());
+                slots.push_back({position, 0});
+            }
+
+            owners.push_back(index);
+            return {index, slots[index].generation};
+        }
+
+        void release_slot(const std::uint32_t index) {
+            Slot &slot = slots[index];
+            // A slot whose generation would wrap around is retired, so old handles can never match again.
+            if (++slot.generation == none) {
+                slot.target = none;
+                return;
+            }
+            slot.target = free_head;
+            free_head = index;
+        }
+
+    public:
+        SlotMap() = default;
+
+        /**
+         * @brief Constructs an empty slot map with room for a number of values.
+         * @param capacity The number of values to reserve storage for.
+         */
+        explicit SlotMap(const std::size_t capacity) {
+            reserve(capacity);
+        }
+
+        /**
+         * @brief Reserves storage so that inserting up to capacity values does not reallocate.
+         */
+        void reserve(const std::size_t capacity) {
+            values.reserve(capacity);
+            owners.reserve(capacity);
+            slots.reserve(capacity);
+        }
+
+        /**
+         * @brief Returns the number of values.
+         */
+        std::size_t size() const noexcept {
+            return values.size();
+        }
+
+        bool empty() const noexcept {
+            return values.empty();
+        }
+
+        /**
+         * @brief Inserts a value.
+         * @return The handle of the new value.
+         * @throws std::runtime_error If the slot map already holds 2^32 - 1 values.
+         */
+        Handle insert(const T &value) {
+            return emplace(value);
+        }
+
+        Handle insert(T &&value) {
+            return emplace(std::move(value));
+        }
+
+        /**
+         * @brief Constructs a value in place.
+         * @param args The arguments forwarded to the constructor of T.
+         * @return The handle of the new value.
+         * @throws std::runtime_error If the slot map already holds 2^32 - 1 values.
+         */
+        template<typename... Args>
+        Handle emplace(Args &&... args) {
+            values.emplace_back(std::forward<Args>(args)...);
+            try {
+                return acquire_slot();
+            } catch (...) {
+                values.pop_back();
+                throw;
+            }
+        }
+
+        /**
+         * @brief Erases the value a handle refers to, moving the last value into its place.
+         * @param handle The handle of the value.
+         * @return true if the value was erased, false if the handle was stale.
+         */
+        bool erase(const Handle handle) {
+            if (!occupied(handle)) return false;
+
+            const std::uint32_t position = slots[handle.index].target;
+            const std::size_t last = values.size() - 1;
+
+            if (position != last) {
+                values[position] = std::move(values[last]);
+                owners[position] = owners[last];
+                slots[owners[position]].target = position;
+            }
+            values.pop_back();
+            owners.pop_back();
+
+            release_slot(handle.index);
+            return true;
+        }
+
+        /**
+         * @brief Checks whether a handle still refers to a value.
+         */
+        bool contains(const Handle handle) const {
+            return occupied(handle);
+        }
+
+        /**
+         * @brief Finds the value a handle refers to.
+         * @return A pointer to the value, or nullptr if the handle is stale.
+         */
+        T *find(const Handle handle) {
+            return occupied(handle) ? &values[slots[handle.index].target] : nullptr;
+        }
+
+        const T *find(const Handle handle) const {
+            return occupied(handle) ? &values[slots[handle.index].target] : nullptr;
+        }
+
+        /**
+         * @brief Returns the value a handle refers to.
+         * @throws std::out_of_range If the handle is stale.
+         */
+        T &at(const Handle handle) {
+            if (!occupied(handle)) throw std::out_of_range("Stale handle");
+            return values[slots[handle.index].target];
+        }
+
+        const T &at(const Handle handle) const {
+            if (!occupied(handle)) throw std::out_of_range("Stale handle");
+            return values[slots[handle.index].target];
+        }
+
+        /**
+         * @brief Returns the handle of the value at a position of the dense array.
+         * @param position The position in [0, size()).
+         * @throws std::out_of_range If the position is out of bounds.
+         */
+        Handle handle_at(const std::size_t position) const {
+            if (position >= values.size()) throw std::out_of_range("Index out of bounds");
+
+            const std::uint32_t index = owners[position];
+            return {index, slots[index].generation};
+        }
+
+        /**
+         * @brief Erases every value. Every outstanding handle becomes stale.
+         */
+        void clear() {
+            for (const std::uint32_t index: owners) release_slot(index);
+            values.clear();
+            owners.clear();
+        }
+
+        /**
+         * @brief Returns a pointer to the dense array of values.
+         */
+        T *data() noexcept {
+            return values.data();
+        }
+
+        const T *data() const noexcept {
+            return values.data();
+        }
+
+        T *begin() noexcept {
+            return values.data();
+        }
+
+        T *end() noexcept {
+            return values.data() + values.size();
+        }
+
+        const T *begin() const noexcept {
+            return values.data();
+        }
+
+        const T *end() const noexcept {
+            return values.data() + values.size();
+        }
+
+        void show() const {
+            std::cout << "{";
+
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                std::cout << owners[i] << ": " << values[i];
+                if (i + 1 < values.size()) {
+                    std::cout << ", ";
+                }
+            }
+
+            std::cout << "}\n";
+        }
+    };
+} // DS
+
+#endif //SLOTMAP_H
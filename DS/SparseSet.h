@@ -0,0 +1,310 @@
+#ifndef SPARSESET_H
+#define SPARSESET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace DS {
+    /**
+     * @brief A set of integers from a bounded universe [0, universe).
+     *
+     * A dense array holds the members in insertion order (up to erasures) and a sparse
+     * array maps each key to its position in the dense array. A key is a member when its
+     * sparse entry points inside the dense prefix and the dense entry points back at it,
+     * so neither array has to be cleared:
+     *  - insert, erase and contains are O(1);
+     *  - clear() is O(1), it only resets the member count;
+     *  - iteration visits only the members, contiguously.
+     *
+     * Erasing moves the last member into the hole, so erasures reorder the members.
+     *
+     * @tparam Index The unsigned integer type of the keys.
+     */
+    template<typename Index = std::uint32_t>
+    class SparseSet {
+        std::vector<Index> sparse; ///< sparse[key] is the dense position of key, if key is a member.
+        std::vector<Index> dense;  ///< dense[0, count) are the members.
+        std::size_t count = 0;
+
+    public:
+        /**
+         * @brief Constructs an empty set over the universe [0, universe).
+         * @param universe One past the largest key.
+         */
+        explicit SparseSet(const std::size_t universe = 0) : sparse(universe), dense(universe) {}
+
+        /**
+         * @brief Returns one past the largest key the set can hold.
+         */
+        std::size_t universe() const noexcept {
+            return sparse.size();
+        }
+
+        /**
+         * @brief Returns the number of members.
+         */
+        std::size_t size() const noexcept {
+            return count;
+        }
+
+        bool empty() const noexcept {
+            return count == 0;
+        }
+
+        /**
+         * @brief Checks whether a key is a member. Keys outside the universe are never members.
+         */
+        bool contains(const Index key) const {
+            if (key >= sparse.size()) return false;
+
+            const Index position = sparse[key];
+            return position < count && dense[position] == key;
+        }
+
+        /**
+         * @brief Adds a key to the set.
+         * @return true if the key was added, false if it was already a member.
+         * @throws std::out_of_range If the key is outside the universe.
+         */
+        bool insert(const Index key) {
+            if (key >= sparse.size()) throw std::out_of_range("Key out of bounds");
+            if (contains(key)) return false;
+
+            dense[count] = key;
+            sparse[key] = static_cast<Index>(count);
+            ++count;
+            return true;
+        }
+
+        /**
+         * @brief Removes a key from the set, moving the last member into its place.
+         * @return true if the key was removed, false if it was not a member.
+         */
+        bool erase(const Index key) {
+            if (!contains(key)) return false;
+
+            const Index position = sparse[key];
+            const Index last = dense[--count];
+            dense[position] = last;
+            sparse[last] = position;
+            return true;
+        }
+
+        /**
+         * @brief Removes every member in O(1).
+         */
+        void clear() noexcept {
+            count = 0;
+        }
+
+        /**
+         * @brief Returns the member at a position of the dense array.
+         * @param position The position in [0, size()).
+         * @throws std::out_of_range If the position is out of bounds.
+         */
+        Index at(const std::size_t position) const {
+            if (position >= count) throw std::out_of_range("Index out of bounds");
+            return dense[position];
+        }
+
+        const Index *data() const noexcept {
+            return dense.data();
+        }
+
+        const Index *begin() const noexcept {
+            return dense.data();
+        }
+
+        const Index *end() const noexcept {
+            return dense.data() + count;
+        }
+
+        void show() const {
+            std::cout << "{";
+
+            for (std::size_t i = 0; i < count; ++i) {
+                std::cout << dense[i];
+                if (i + 1 < count) {
+                    std::cout << ", ";
+                }
+            }
+
+            std::cout << "}\n";
+        }
+    };
+
+    /**
+     * @brief A map from integers of a bounded universe [0, universe) to values.
+     *
+     * This is a SparseSet whose dense array of keys has a parallel dense array of values,
+     * so values are iterated contiguously alongside their keys. insert, erase, find and
+     * contains are O(1), and clear() is O(1): the dense value array is allocated once for
+     * the whole universe, and the values of removed keys are only overwritten when their
+     * positions are reused.
+     *
+     * @tparam V The type of the values. Must be default-constructible and assignable.
+     * @tparam Index The unsigned integer type of the keys.
+     */
+    template<typename V, typename Index = std::uint32_t>
+    class SparseMap {
+        std::vector<Index> sparse;
+        std::vector<Index> keys;
+        std::vector<V> values; ///< values[i] belongs to keys[i].
+        std::size_t count = 0;
+
+    public:
+        /**
+         * @brief Constructs an empty map over the universe [0, universe).
+         * @param universe One past the largest key.
+         */
+        explicit SparseMap(const std::size_t universe = 0) : sparse(universe), keys(universe), values(universe) {}
+
+        /**
+         * @brief Returns one past the largest key the map can hold.
+         */
+        std::size_t universe() const noexcept {
+            return sparse.size();
+        }
+
+        /**
+         * @brief Returns the number of keys.
+         */
+        std::size_t size() const noexcept {
+            return count;
+        }
+
+        bool empty() const noexcept {
+            return count == 0;
+        }
+
+        /**
+         * @brief Checks whether a key is present. Keys outside the universe are never present.
+         */
+        bool contains(const Index key) const {
+            if (key >= sparse.size()) return false;
+
+            const Index position = sparse[key];
+            return position < count && keys[position] == key;
+        }
+
+        /**
+         * @brief Inserts a key with a value, or replaces the value of a present key.
+         * @return true if the key was inserted, false if its value was replaced.
+         * @throws std::out_of_range If the key is outside the universe.
+         */
+        bool insert_or_assign(const Index key, V value) {
+            if (key >= sparse.size()) throw std::out_of_range("Key out of bounds");
+
+            if (contains(key)) {
+                values[sparse[key]] = std::move(value);
+                return false;
+            }
+
+            keys[count] = key;
+            values[count] = std::move(value);
+            sparse[key] = static_cast<Index>(count);
+            ++count;
+            return true;
+        }
+
+        /**
+         * @brief Removes a key, moving the last key and value into its place.
+         * @return true if the key was removed, false if it was not present.
+         */
+        bool erase(const Index key) {
+            if (!contains(key)) return false;
+
+            const Index position = sparse[key];
+            const std::size_t last = --count;
+            if (position != last) {
+                keys[position] = keys[last];
+                values[position] = std::move(values[last]);
+                sparse[keys[position]] = position;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Finds the value of a key.
+         * @return A pointer to the value, or nullptr if the key is not present.
+         */
+        V *find(const Index key) {
+            return contains(key) ? &values[sparse[key]] : nullptr;
+        }
+
+        const V *find(const Index key) const {
+            return contains(key) ? &values[sparse[key]] : nullptr;
+        }
+
+        /**
+         * @brief Returns the value of a key.
+         * @throws std::out_of_range If the key is not present.
+         */
+        V &at(const Index key) {
+            if (!contains(key)) throw std::out_of_range("Key not found");
+            return values[sparse[key]];
+        }
+
+        const V &at(const Index key) const {
+            if (!contains(key)) throw std::out_of_range("Key not found");
+            return values[sparse[key]];
+        }
+
+        /**
+         * @brief Removes every key in O(1).
+         */
+        void clear() noexcept {
+            count = 0;
+        }
+
+        /**
+         * @brief Returns the dense array of keys; key_data()[i] owns value_data()[i].
+         */
+        const Index *key_data() const noexcept {
+            return keys.data();
+        }
+
+        /**
+         * @brief Returns the dense array of values; value_data()[i] belongs to key_data()[i].
+         */
+        V *value_data() noexcept {
+            return values.data();
+        }
+
+        const V *value_data() const noexcept {
+            return values.data();
+        }
+
+        /**
+         * @brief Calls fn(key, value) for every key, in dense order.
+         */
+        template<typename Fn>
+        void for_each(Fn fn) {
+            for (std::size_t i = 0; i < count; ++i) fn(keys[i], values[i]);
+        }
+
+        template<typename Fn>
+        void for_each(Fn fn) const {
+            for (std::size_t i = 0; i < count; ++i) fn(keys[i], values[i]);
+        }
+
+        void show() const {
+            std::cout << "{";
+
+            for (std::size_t i = 0; i < count; ++i) {
+                std::cout << keys[i] << ": " << values[i];
+                if (i + 1 < count) {
+                    std::cout << ", ";
+                }
+            }
+
+            std::cout << "}\n";
+        }
+    };
+} // DS
+
+#endif //SPARSESET_H
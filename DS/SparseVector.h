@@ -0,0 +1,506 @@
+#ifndef SPARSEVECTOR_H
+#define SPARSEVECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "Array.h"
+#include "Hash.h"
+
+namespace DS {
+    /**
+     * @brief A vector of a large dimension with few non-zero entries.
+     *
+     * Only the non-zero entries are stored, as a sorted array of indices and a parallel
+     * array of values. Lookups are binary searches; dot products and sums of two sparse
+     * vectors merge the two index arrays in one pass, and the dot product with a dense
+     * vector gathers the dense entries at the stored indices.
+     *
+     * Inserting into the sorted arrays moves the entries after the new one, so long runs
+     * of random updates should go through the hashed mode: begin_updates() moves the
+     * entries into a hash table with O(1) get() and set(), and end_updates() sorts them
+     * back. Only get(), set(), nnz() and dimension() are available in the hashed mode.
+     *
+     * @tparam T The type of the values. Must be an arithmetic type.
+     * @tparam Index The unsigned integer type of the indices.
+     */
+    template<typename T = float, typename Index = std::uint32_t>
+    class SparseVector {
+        static_assert(std::is_arithmetic<T>::value, "SparseVector requires an arithmetic type");
+
+        static constexpr Index empty_slot = std::numeric_limits<Index>::max();
+        static constexpr std::size_t gallop_ratio = 32; ///< Size ratio above which dot() gallops through the larger vector.
+
+        std::size_t n;
+        std::vector<Index> indices;
+        std::vector<T> values;
+
+        bool hashed = false;
+        std::vector<Index> slot_indices; ///< Hash table of the hashed mode; empty_slot marks a free slot.
+        std::vector<T> slot_values;
+        std::size_t slot_count = 0; ///< Occupied slots, including entries set to zero.
+
+        void check(const std::size_t index) const {
+            if (index >= n) throw std::out_of_range("Index out of bounds");
+        }
+
+        void require_sorted() const {
+            if (hashed) throw std::runtime_error("SparseVector is in hashed mode");
+        }
+
+        std::size_t probe(const Index index) const {
+            const std::size_t mask = slot_indices.size() - 1;
+            std::size_t slot = static_cast<std::size_t>(mix64(index)) & mask;
+            while (slot_indices[slot] != empty_slot && slot_indices[slot] != index) slot = (slot + 1) & mask;
+            return slot;
+        }
+
+        void rehash(const std::size_t capacity) {
+            std::vector<Index> old_indices(capacity, empty_slot);
+            std::vector<T> old_values(capacity, T());
+            old_indices.swap(slot_indices);
+            old_values.swap(slot_values);
+            slot_count = 0;
+
+            for (std::size_t slot = 0; slot < old_indices.size(); ++slot) {
+                if (old_indices[slot] == empty_slot || old_values[slot] == T()) continue;
+                const std::size_t target = probe(old_indices[slot]);
+                slot_indices[target] = old_indices[slot];
+                slot_values[target] = old_values[slot];
+                ++slot_count;
+            }
+        }
+
+        /**
+         * @brief Returns the position of the first stored index not less than index, starting the search at first.
+         */
+        std::size_t lower_bound(const Index index, const std::size_t first = 0) const {
+            return static_cast<std::size_t>(std::lower_bound(indices.begin() + static_cast<std::ptrdiff_t>(first),
+                                                             indices.end(), index) - indices.begin());
+        }
+
+        /**
+         * @brief Dot product when this vector has far fewer entries: each entry gallops through the other one.
+         */
+        T gallop_dot(const SparseVector &larger) const {
+            T sum = T();
+            std::size_t position = 0;
+            for (std::size_t i = 0; i < indices.size() && position < larger.indices.size(); ++i) {
+                // Exponential search from the last match, then a binary search in the bracket found.
+                std::size_t step = 1;
+                std::size_t high = position;
+                while (high < larger.indices.size() && larger.indices[high] < indices[i]) {
+                    position = high + 1;
+                    high += step;
+                    step *= 2;
+                }
+                high = std::min(high, larger.indices.size());
+                position = static_cast<std::size_t>(
+                    std::lower_bound(larger.indices.begin() + static_cast<std::ptrdiff_t>(position),
+                                     larger.indices.begin() + static_cast<std::ptrdiff_t>(high), indices[i]) -
+                    larger.indices.begin());
+                if (position < larger.indices.size() && larger.indices[position] == indices[i]) {
+                    sum += values[i] * larger.values[position];
+                }
+            }
+            return sum;
+        }
+
+    public:
+        /**
+         * @brief Constructs a zero vector.
+         *
+         * @param dimension The number of entries, zero or not.
+         * @throws std::runtime_error If the dimension does not fit in Index.
+         */
+        explicit SparseVector(const std::size_t dimension = 0) : n(dimension) {
+            if (dimension > empty_slot) throw std::runtime_error("Dimension too large");
+        }
+
+        /**
+         * @brief Constructs a sparse vector holding the non-zero entries of a dense DS::Array.
+         */
+        explicit SparseVector(const Array<T> &dense) : SparseVector(static_cast<std::size_t>(dense.size())) {
+            for (int i = 0; i < dense.size(); ++i) {
+                const T value = dense.at(i);
+                if (value == T()) continue;
+                indices.push_back(static_cast<Index>(i));
+                values.push_back(value);
+            }
+        }
+
+        /**
+         * @brief Constructs a sparse vector from parallel arrays of indices and values, in any order.
+         *
+         * Zero values are dropped.
+         *
+         * @throws std::out_of_range If an index is not less than the dimension.
+         * @throws std::runtime_error If an index appears twice.
+         */
+        SparseVector(const std::size_t dimension, const Index *entry_indices, const T *entry_values,
+                     const std::size_t count) : SparseVector(dimension) {
+            std::vector<std::size_t> order(count);
+            std::iota(order.begin(), order.end(), std::size_t{0});
+            std::sort(order.begin(), order.end(),
+                      [entry_indices](const std::size_t x, const std::size_t y) {
+                          return entry_indices[x] < entry_indices[y];
+                      });
+
+            indices.reserve(count);
+            values.reserve(count);
+            for (std::size_t k = 0; k < count; ++k) {
+                const std::size_t entry = order[k];
+                check(entry_indices[entry]);
+                if (k > 0 && entry_indices[order[k - 1]] == entry_indices[entry]) {
+                    throw std::runtime_error("Duplicate index");
+                }
+                if (entry_values[entry] == T()) continue;
+                indices.push_back(entry_indices[entry]);
+                values.push_back(entry_values[entry]);
+            }
+        }
+
+        std::size_t dimension() const noexcept {
+            return n;
+        }
+
+        /**
+         * @brief Returns the number of stored entries.
+         *
+         * In the hashed mode, entries set to zero may be counted until end_updates().
+         */
+        std::size_t nnz() const noexcept {
+            return hashed ? slot_count : indices.size();
+        }
+
+        bool is_hashed() const noexcept {
+            return hashed;
+        }
+
+        /**
+         * @brief Returns an entry.
+         * @throws std::out_of_range If the index is not less than the dimension.
+         */
+        T get(const std::size_t index) const {
+            check(index);
+            if (hashed) {
+                const std::size_t slot = probe(static_cast<Index>(index));
+                return slot_indices[slot] == empty_slot ? T() : slot_values[slot];
+            }
+
+            const std::size_t position = lower_bound(static_cast<Index>(index));
+            if (position < indices.size() && indices[position] == index) return values[position];
+            return T();
+        }
+
+        T operator[](const std::size_t index) const {
+            return get(index);
+        }
+
+        /**
+         * @brief Sets an entry; setting it to zero removes it.
+         *
+         * O(1) in the hashed mode, O(nnz()) in the sorted mode unless the index is already stored.
+         *
+         * @throws std::out_of_range If the index is not less than the dimension.
+         */
+        void set(const std::size_t index, const T &value) {
+            check(index);
+            const auto key = static_cast<Index>(index);
+
+            if (hashed) {
+                std::size_t slot = probe(key);
+                if (slot_indices[slot] == empty_slot) {
+                    if (value == T()) return;
+                    if (2 * (slot_count + 1) > slot_indices.size()) {
+                        rehash(2 * slot_indices.size());
+                        slot = probe(key);
+                    }
+                    slot_indices[slot] = key;
+                    ++slot_count;
+                }
+                // Zeros stay in the table as tombstones until the next rehash or end_updates().
+                slot_values[slot] = value;
+                return;
+            }
+
+            const std::size_t position = lower_bound(key);
+            const bool present = position < indices.size() && indices[position] == key;
+            if (value == T()) {
+                if (present) {
+                    indices.erase(indices.begin() + static_cast<std::ptrdiff_t>(position));
+                    values.erase(values.begin() + static_cast<std::ptrdiff_t>(position));
+                }
+            } else if (present) {
+                values[position] = value;
+            } else {
+                indices.insert(indices.begin() + static_cast<std::ptrdiff_t>(position), key);
+                values.insert(values.begin() + static_cast<std::ptrdiff_t>(position), value);
+            }
+        }
+
+        /**
+         * @brief Switches to the hashed mode for a run of random updates.
+         */
+        void begin_updates() {
+            if (hashed) return;
+
+            std::size_t capacity = 16;
+            while (capacity < 2 * indices.size()) capacity *= 2;
+            slot_indices.assign(capacity, empty_slot);
+            slot_values.assign(capacity, T());
+            slot_count = 0;
+            hashed = true;
+
+            for (std::size_t i = 0; i < indices.size(); ++i) {
+                const std::size_t slot = probe(indices[i]);
+                slot_indices[slot] = indices[i];
+                slot_values[slot] = values[i];
+                ++slot_count;
+            }
+            indices.clear();
+            values.clear();
+        }
+
+        /**
+         * @brief Sorts the entries of the hashed mode back into the sorted arrays.
+         */
+        void end_updates() {
+            if (!hashed) return;
+
+            std::vector<std::pair<Index, T> > entries;
+            entries.reserve(slot_count);
+            for (std::size_t slot = 0; slot < slot_indices.size(); ++slot) {
+                if (slot_indices[slot] != empty_slot && slot_values[slot] != T()) {
+                    entries.emplace_back(slot_indices[slot], slot_values[slot]);
+                }
+            }
+            std::sort(entries.begin(), entries.end(),
+                      [](const std::pair<Index, T> &x, const std::pair<Index, T> &y) { return x.first < y.first; });
+
+            indices.resize(entries.size());
+            values.resize(entries.size());
+            for (std::size_t i = 0; i < entries.size(); ++i) {
+                indices[i] = entries[i].first;
+                values[i] = entries[i].second;
+            }
+
+            hashed = false;
+            std::vector<Index>().swap(slot_indices);
+            std::vector<T>().swap(slot_values);
+            slot_count = 0;
+        }
+
+        /**
+         * @brief Returns the sorted indices of the stored entries.
+         * @throws std::runtime_error In the hashed mode.
+         */
+        const std::vector<Index> &index_data() const {
+            require_sorted();
+            return indices;
+        }
+
+        /**
+         * @brief Returns the values of the stored entries, in the order of index_data().
+         * @throws std::runtime_error In the hashed mode.
+         */
+        const std::vector<T> &value_data() const {
+            require_sorted();
+            return values;
+        }
+
+        /**
+         * @brief Computes the dot product with another sparse vector by merging the two index arrays.
+         *
+         * When one vector has far more entries than the other, the smaller one gallops
+         * through the larger one instead, in O(m log(n / m)).
+         *
+         * @throws std::runtime_error If the dimensions differ or either vector is in the hashed mode.
+         */
+        T dot(const SparseVector &other) const {
+            require_sorted();
+            other.require_sorted();
+            if (n != other.n) throw std::runtime_error("Dimensions do not match");
+
+            if (indices.size() * gallop_ratio < other.indices.size()) return gallop_dot(other);
+            if (other.indices.size() * gallop_ratio < indices.size()) return other.gallop_dot(*this);
+
+            T sum = T();
+            std::size_t i = 0;
+            std::size_t j = 0;
+            while (i < indices.size() && j < other.indices.size()) {
+                if (indices[i] < other.indices[j]) {
+                    ++i;
+                } else if (other.indices[j] < indices[i]) {
+                    ++j;
+                } else {
+                    sum += values[i++] * other.values[j++];
+                }
+            }
+            return sum;
+        }
+
+        /**
+         * @brief Computes the dot product with a dense vector, gathering its entries at the stored indices.
+         *
+         * @param dense dimension() values.
+         * @throws std::runtime_error In the hashed mode.
+         */
+        T dot(const T *dense) const {
+            require_sorted();
+            T sum = T();
+            std::size_t i = 0;
+#if defined(__AVX2__)
+            if constexpr (std::is_same<T, float>::value && sizeof(Index) == 4) {
+                // Indices fit in 31 bits unless the dimension exceeds INT32_MAX; the gather takes signed offsets.
+                if (n <= static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max())) {
+                    __m256 acc = _mm256_setzero_ps();
+                    for (; i + 8 <= indices.size(); i += 8) {
+                        const __m256i offsets = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(indices.data() + i));
+                        const __m256 gathered = _mm256_i32gather_ps(dense, offsets, 4);
+                        acc = _mm256_add_ps(acc, _mm256_mul_ps(gathered, _mm256_loadu_ps(values.data() + i)));
+                    }
+                    alignas(32) float lanes[8];
+                    _mm256_store_ps(lanes, acc);
+                    for (const float lane: lanes) sum += lane;
+                }
+            }
+#endif
+            for (; i < indices.size(); ++i) sum += values[i] * dense[indices[i]];
+            return sum;
+        }
+
+        /**
+         * @brief Computes the dot product with a dense DS::Array.
+         * @throws std::runtime_error If the dimensions differ or the vector is in the hashed mode.
+         */
+        T dot(const Array<T> &dense) const {
+            if (static_cast<std::size_t>(dense.size()) != n) throw std::runtime_error("Dimensions do not match");
+            return dot(dense.begin());
+        }
+
+        /**
+         * @brief Returns the sum with another sparse vector, merging the two index arrays.
+         *
+         * Entries that cancel out are not stored.
+         *
+         * @throws std::runtime_error If the dimensions differ or either vector is in the hashed mode.
+         */
+        SparseVector operator+(const SparseVector &other) const {
+            require_sorted();
+            other.require_sorted();
+            if (n != other.n) throw std::runtime_error("Dimensions do not match");
+
+            SparseVector result(n);
+            result.indices.reserve(indices.size() + other.indices.size());
+            result.values.reserve(indices.size() + other.indices.size());
+
+            std::size_t i = 0;
+            std::size_t j = 0;
+            while (i < indices.size() || j < other.indices.size()) {
+                Index index;
+                T value;
+                if (j == other.indices.size() || (i < indices.size() && indices[i] < other.indices[j])) {
+                    index = indices[i];
+                    value = values[i++];
+                } else if (i == indices.size() || other.indices[j] < indices[i]) {
+                    index = other.indices[j];
+                    value = other.values[j++];
+                } else {
+                    index = indices[i];
+                    value = values[i++] + other.values[j++];
+                    if (value == T()) continue;
+                }
+                result.indices.push_back(index);
+                result.values.push_back(value);
+            }
+            return result;
+        }
+
+        SparseVector &operator+=(const SparseVector &other) {
+            *this = *this + other;
+            return *this;
+        }
+
+        /**
+         * @brief Multiplies every entry by a scalar.
+         * @throws std::runtime_error In the hashed mode.
+         */
+        SparseVector &operator*=(const T &scalar) {
+            require_sorted();
+            if (scalar == T()) {
+                indices.clear();
+                values.clear();
+                return *this;
+            }
+            for (T &value: values) value *= scalar;
+            return *this;
+        }
+
+        /**
+         * @brief Writes the vector as dimension() dense values.
+         *
+         * @param dense dimension() values to overwrite.
+         * @throws std::runtime_error In the hashed mode.
+         */
+        void densify(T *dense) const {
+            require_sorted();
+            std::fill(dense, dense + n, T());
+            for (std::size_t i = 0; i < indices.size(); ++i) dense[indices[i]] = values[i];
+        }
+
+        /**
+         * @brief Appends the vector as dimension() dense values to a DS::Array.
+         * @throws std::runtime_error In the hashed mode.
+         */
+        void densify(Array<T> &dense) const {
+            std::vector<T> buffer(n);
+            densify(buffer.data());
+            const int needed = dense.size() + static_cast<int>(n);
+            if (needed > dense.capacity()) dense.resize(needed);
+            for (const T &value: buffer) dense.push_back(value);
+        }
+
+        /**
+         * @brief Displays the stored entries as index: value pairs to the standard output.
+         */
+        void show() const {
+            std::cout << "{";
+
+            bool first = true;
+            const auto print = [&first](const Index index, const T &value) {
+                if (!first) {
+                    std::cout << ", ";
+                }
+                std::cout << index << ": " << value;
+                first = false;
+            };
+
+            if (hashed) {
+                for (std::size_t slot = 0; slot < slot_indices.size(); ++slot) {
+                    if (slot_indices[slot] != empty_slot && slot_values[slot] != T()) {
+                        print(slot_indices[slot], slot_values[slot]);
+                    }
+                }
+            } else {
+                for (std::size_t i = 0; i < indices.size(); ++i) print(indices[i], values[i]);
+            }
+
+            std::cout << "}\n";
+        }
+    };
+} // DS
+
+#endif //SPARSEVECTOR_H
@@ -0,0 +1,366 @@
+#ifndef STRINGPOOL_H
+#define STRINGPOOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "Array.h"
+#include "Hash.h"
+
+namespace DS {
+    /**
+     * @brief An array of strings whose characters share one contiguous buffer.
+     *
+     * Appending a string copies its characters to the end of a single growable buffer and
+     * records its offset and length in two flat arrays, so there is no allocation per
+     * string and at() is two loads. find() scans the flat length array first (eight
+     * lengths per step with AVX2) and only compares the characters of strings of the
+     * right length.
+     *
+     * With interning enabled, equal strings are stored once: push_back() of a string that
+     * is already present returns the existing index, and find() is a hash table lookup.
+     *
+     * Strings are limited to 2^32 - 1 characters each.
+     */
+    class StringPool {
+        static constexpr char magic[4] = {'D', 'S', 'S', 'P'};
+        static constexpr std::uint32_t format_version = 1;
+
+        std::vector<char> chars;
+        std::vector<std::uint64_t> offsets;
+        std::vector<std::uint32_t> lengths;
+
+        bool interning;
+        std::vector<std::uint32_t> table; ///< Open addressing on string index + 1; 0 marks an empty bucket.
+
+        static std::size_t hash_of(const std::string_view value) {
+            return Hash<std::string_view>{}(value);
+        }
+
+        bool equal_at(const std::size_t index, const std::string_view value) const {
+            return lengths[index] == value.size() &&
+                   (value.empty() || std::memcmp(chars.data() + offsets[index], value.data(), value.size()) == 0);
+        }
+
+        /**
+         * @brief Returns the bucket holding a string, or the empty bucket where it belongs.
+         */
+        std::size_t probe(const std::string_view value) const {
+            const std::size_t mask = table.size() - 1;
+            std::size_t bucket = hash_of(value) & mask;
+
+            while (table[bucket] != 0 && !equal_at(table[bucket] - 1, value)) bucket = (bucket + 1) & mask;
+            return bucket;
+        }
+
+        void rehash(const std::size_t buckets) {
+            table.assign(buckets, 0);
+            for (std::size_t i = 0; i < lengths.size(); ++i) {
+                table[probe(view(i))] = static_cast<std::uint32_t>(i + 1);
+            }
+        }
+
+        std::string_view view(const std::size_t index) const {
+            return {chars.data() + offsets[index], lengths[index]};
+        }
+
+        std::size_t append(const std::string_view value) {
+            if (value.size() > std::numeric_limits<std::uint32_t>::max()) {
+                throw std::runtime_error("String is too long");
+            }
+
+            offsets.push_back(chars.size());
+            lengths.push_back(static_cast<std::uint32_t>(value.size()));
+            chars.insert(chars.end(), value.begin(), value.end());
+            return lengths.size() - 1;
+        }
+
+        static void write_u32(std::vector<std::uint8_t> &out, const std::uint32_t value) {
+            for (std::size_t i = 0; i < 4; ++i) out.push_back(static_cast<std::uint8_t>(value >> (i * 8)));
+        }
+
+        static std::uint32_t read_u32(const std::uint8_t *in) {
+            std::uint32_t value = 0;
+            for (std::size_t i = 0; i < 4; ++i) value |= static_cast<std::uint32_t>(in[i]) << (i * 8);
+            return value;
+        }
+
+        static void write_u64(std::vector<std::uint8_t> &out, const std::uint64_t value) {
+            for (std::size_t i = 0; i < 8; ++i) out.push_back(static_cast<std::uint8_t>(value >> (i * 8)));
+        }
+
+        static std::uint64_t read_u64(const std::uint8_t *in) {
+            std::uint64_t value = 0;
+            for (std::size_t i = 0; i < 8; ++i) value |= static_cast<std::uint64_t>(in[i]) << (i * 8);
+            return value;
+        }
+
+    public:
+        /**
+         * @brief Constructs an empty pool.
+         * @param interning Whether equal strings should be stored only once.
+         */
+        explicit StringPool(const bool interning = false) : interning(interning) {
+            if (interning) table.assign(16, 0);
+        }
+
+        /**
+         * @brief Builds a pool from the strings of a DS::Array.
+         * @param array The strings, in order.
+         * @param interning Whether equal strings should be stored only once.
+         */
+        explicit StringPool(const Array<std::string> &array, const bool interning = false) : StringPool(interning) {
+            std::size_t total = 0;
+            for (int i = 0; i < array.size(); ++i) total += array.at(i).size();
+            reserve(static_cast<std::size_t>(array.size()), total);
+
+            for (int i = 0; i < array.size(); ++i) push_back(array.at(i));
+        }
+
+        /**
+         * @brief Reserves room for a number of strings and characters.
+         * @param strings The number of strings.
+         * @param characters The total number of characters.
+         */
+        void reserve(const std::size_t strings, const std::size_t characters) {
+            offsets.reserve(strings);
+            lengths.reserve(strings);
+            chars.reserve(characters);
+            if (interning && table.size() < 2 * strings) {
+                std::size_t buckets = table.size();
+                while (buckets < 2 * strings) buckets *= 2;
+                rehash(buckets);
+            }
+        }
+
+        /**
+         * @brief Returns the number of strings.
+         */
+        std::size_t size() const noexcept {
+            return lengths.size();
+        }
+
+        bool empty() const noexcept {
+            return lengths.empty();
+        }
+
+        /**
+         * @brief Returns the total number of characters stored.
+         */
+        std::size_t char_count() const noexcept {
+            return chars.size();
+        }
+
+        bool is_interning() const noexcept {
+            return interning;
+        }
+
+        /**
+         * @brief Appends a string, or finds it if interning is enabled and it is already present.
+         * @param value The string.
+         * @return The index of the string.
+         * @throws std::runtime_error If the string has 2^32 or more characters, or an interning pool is full.
+         */
+        std::size_t push_back(const std::string_view value) {
+            if (!interning) return append(value);
+
+            std::size_t bucket = probe(value);
+            if (table[bucket] != 0) return table[bucket] - 1;
+
+            if (lengths.size() >= std::numeric_limits<std::uint32_t>::max() - 1) {
+                throw std::runtime_error("StringPool is full");
+            }
+
+            const std::size_t index = append(value);
+            // Keep the load factor at or below 1/2.
+            if (2 * lengths.size() > table.size()) {
+                rehash(table.size() * 2);
+            } else {
+                table[bucket] = static_cast<std::uint32_t>(index + 1);
+            }
+            return index;
+        }
+
+        /**
+         * @brief Returns the string at an index.
+         *
+         * The view stays valid until the next push_back() or clear().
+         *
+         * @param index The index of the string (0-indexed).
+         * @throws std::out_of_range If the index is out of bounds.
+         */
+        std::string_view at(const std::size_t index) const {
+            if (index >= lengths.size()) throw std::out_of_range("Index out of bounds");
+            return view(index);
+        }
+
+        std::string_view operator[](const std::size_t index) const {
+            return at(index);
+        }
+
+        /**
+         * @brief Returns the length of the string at an index without touching its characters.
+         * @throws std::out_of_range If the index is out of bounds.
+         */
+        std::size_t length(const std::size_t index) const {
+            if (index >= lengths.size()) throw std::out_of_range("Index out of bounds");
+            return lengths[index];
+        }
+
+        /**
+         * @brief Finds the first occurrence of a string.
+         * @param value The string to find.
+         * @return The index of the string, or -1 if it is not present.
+         */
+        std::ptrdiff_t find(const std::string_view value) const {
+            if (interning) {
+                const std::uint32_t entry = table[probe(value)];
+                return entry == 0 ? -1 : static_cast<std::ptrdiff_t>(entry) - 1;
+            }
+
+            if (value.size() > std::numeric_limits<std::uint32_t>::max()) return -1;
+
+            const auto target = static_cast<std::uint32_t>(value.size());
+            const std::size_t n = lengths.size();
+            std::size_t i = 0;
+
+#if defined(__AVX2__)
+            const __m256i wanted = _mm256_set1_epi32(static_cast<int>(target));
+            for (; i + 8 <= n; i += 8) {
+                const __m256i batch = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lengths.data() + i));
+                auto mask = static_cast<unsigned>(
+                    _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(batch, wanted))));
+
+                for (; mask != 0; mask &= mask - 1) {
+                    const std::size_t index = i + static_cast<std::size_t>(__builtin_ctz(mask));
+                    if (equal_at(index, value)) return static_cast<std::ptrdiff_t>(index);
+                }
+            }
+#endif
+
+            for (; i < n; ++i) {
+                if (lengths[i] == target && equal_at(i, value)) return static_cast<std::ptrdiff_t>(i);
+            }
+            return -1;
+        }
+
+        bool contains(const std::string_view value) const {
+            return find(value) != -1;
+        }
+
+        /**
+         * @brief Removes every string, keeping the allocated storage.
+         */
+        void clear() {
+            chars.clear();
+            offsets.clear();
+            lengths.clear();
+            if (interning) table.assign(table.size(), 0);
+        }
+
+        /**
+         * @brief Serializes the pool to a portable little-endian byte string.
+         *
+         * Layout: "DSSP", u32 format version, u32 flags (bit 0: interning), u64 string
+         * count, u64 character count, one u32 length per string, then the characters of
+         * every string back to back.
+         *
+         * @return The serialized pool.
+         */
+        std::vector<std::uint8_t> serialize() const {
+            std::vector<std::uint8_t> out;
+            out.reserve(28 + 4 * lengths.size() + chars.size());
+            for (const char c: magic) out.push_back(static_cast<std::uint8_t>(c));
+            write_u32(out, format_version);
+            write_u32(out, interning ? 1 : 0);
+            write_u64(out, lengths.size());
+            write_u64(out, chars.size());
+
+            for (const std::uint32_t length: lengths) write_u32(out, length);
+            // Strings are appended in index order, so the buffer already is the concatenation.
+            out.insert(out.end(), chars.begin(), chars.end());
+
+            return out;
+        }
+
+        /**
+         * @brief Rebuilds a pool from the output of serialize().
+         * @param bytes The serialized pool.
+         * @return The pool.
+         * @throws std::runtime_error If the bytes are not a valid serialized pool.
+         */
+        static StringPool deserialize(const std::vector<std::uint8_t> &bytes) {
+            if (bytes.size() < 28 || std::memcmp(bytes.data(), magic, 4) != 0) {
+                throw std::runtime_error("Invalid string pool data");
+            }
+            if (read_u32(bytes.data() + 4) != format_version) {
+                throw std::runtime_error("Unsupported string pool version");
+            }
+
+            const std::uint32_t flags = read_u32(bytes.data() + 8);
+            const std::uint64_t count = read_u64(bytes.data() + 12);
+            const std::uint64_t characters = read_u64(bytes.data() + 20);
+            const std::size_t payload = bytes.size() - 28;
+
+            if (flags > 1 || count > payload / 4 || characters != payload - 4 * count) {
+                throw std::runtime_error("Invalid string pool data");
+            }
+
+            StringPool pool(flags == 1);
+            pool.lengths.resize(static_cast<std::size_t>(count));
+            pool.offsets.resize(static_cast<std::size_t>(count));
+
+            const std::uint8_t *in = bytes.data() + 28;
+            std::uint64_t offset = 0;
+            for (std::size_t i = 0; i < pool.lengths.size(); ++i) {
+                pool.lengths[i] = read_u32(in + 4 * i);
+                pool.offsets[i] = offset;
+                offset += pool.lengths[i];
+            }
+            if (offset != characters) throw std::runtime_error("Invalid string pool data");
+
+            in += 4 * count;
+            pool.chars.assign(reinterpret_cast<const char *>(in), reinterpret_cast<const char *>(in) + characters);
+
+            if (pool.interning) {
+                std::size_t buckets = 16;
+                while (buckets < 2 * pool.lengths.size()) buckets *= 2;
+                pool.table.assign(buckets, 0);
+                for (std::size_t i = 0; i < pool.lengths.size(); ++i) {
+                    // An interning pool stores every string once.
+                    const std::size_t bucket = pool.probe(pool.view(i));
+                    if (pool.table[bucket] != 0) throw std::runtime_error("Invalid string pool data");
+                    pool.table[bucket] = static_cast<std::uint32_t>(i + 1);
+                }
+            }
+
+            return pool;
+        }
+
+        void show() const {
+            std::cout << "{";
+
+            for (std::size_t i = 0; i < lengths.size(); ++i) {
+                std::cout << '"' << view(i) << '"';
+                if (i + 1 < lengths.size()) {
+                    std::cout << ", ";
+                }
+            }
+
+            std::cout << "}\n";
+        }
+    };
+} // DS
+
+#endif //STRINGPOOL_H
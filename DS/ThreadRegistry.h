@@ -0,0 +1,115 @@
+#ifndef THREADREGISTRY_H
+#define THREADREGISTRY_H
+
+#include <atomic>
+#include <cstddef>
+
+namespace DS {
+    /**
+     * @brief Links and ownership flag of a record kept in a ThreadRegistry.
+     *
+     * Derive the record type from it: struct Record : ThreadRecord<Record> { ... }.
+     */
+    template<typename Record>
+    struct ThreadRecord {
+        std::atomic<bool> owned{false};
+        Record *next = nullptr; ///< Next record of the registry; records are never unlinked.
+    };
+
+    /**
+     * @brief A lock-free registry of per-thread records, shared by the memory reclamation schemes.
+     *
+     * Every thread that calls local() gets a record of its own. Records are pushed onto a
+     * list that only grows, so other threads can scan it without locks at any time. When
+     * a thread exits, the record's release() member runs on that thread and the record is
+     * handed to the next thread that registers, so the list stays as long as the largest
+     * number of threads alive at once, however many threads come and go.
+     *
+     * The registry deletes its records when it is destroyed.
+     *
+     * @tparam Record A type derived from ThreadRecord<Record>, with a default constructor
+     *                and a member void release() that resets it for the next owner.
+     */
+    template<typename Record>
+    class ThreadRegistry {
+        std::atomic<Record *> records{nullptr};
+        std::atomic<std::size_t> record_count{0};
+
+        struct Handle {
+            Record *record = nullptr;
+
+            ~Handle() {
+                if (record == nullptr) return;
+                record->release();
+                record->owned.store(false, std::memory_order_release);
+            }
+        };
+
+        Record *acquire() {
+            for (Record *record = records.load(std::memory_order_acquire); record != nullptr;
+                 record = record->next) {
+                bool expected = false;
+                if (!record->owned.load(std::memory_order_relaxed) &&
+                    record->owned.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                    return record;
+                }
+            }
+
+            auto *record = new Record();
+            record->owned.store(true, std::memory_order_relaxed);
+            Record *head = records.load(std::memory_order_relaxed);
+            do {
+                record->next = head;
+            } while (!records.compare_exchange_weak(head, record, std::memory_order_release,
+                                                   std::memory_order_relaxed));
+            record_count.fetch_add(1, std::memory_order_relaxed);
+            return record;
+        }
+
+    public:
+        ThreadRegistry() = default;
+
+        /**
+         * @brief Deletes every record. No thread may use the registry any more.
+         */
+        ~ThreadRegistry() {
+            for (Record *record = records.load(); record != nullptr;) {
+                Record *next = record->next;
+                delete record;
+                record = next;
+            }
+        }
+
+        ThreadRegistry(const ThreadRegistry &) = delete;
+
+        ThreadRegistry &operator=(const ThreadRegistry &) = delete;
+
+        /**
+         * @brief Returns the calling thread's record, registering the thread on its first call.
+         *
+         * There must be only one registry per record type, since the thread-local handle is
+         * shared by all registries of the same type.
+         */
+        Record &local() {
+            thread_local Handle handle;
+            if (handle.record == nullptr) handle.record = acquire();
+            return *handle.record;
+        }
+
+        /**
+         * @brief Returns the most recently added record; follow next for the others.
+         */
+        Record *first() const noexcept {
+            return records.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Returns the number of records, owned or not.
+         */
+        std::size_t size() const noexcept {
+            return record_count.load(std::memory_order_relaxed);
+        }
+    };
+} // DS
+
+#endif //THREADREGISTRY_H
@@ -0,0 +1,112 @@
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace DS {
+    /**
+     * @brief Publishes the latest value from one writer thread to one reader thread.
+     *
+     * The writer fills a back buffer in place and publishes it; the reader picks up the
+     * newest published buffer and keeps reading it until it asks for an update. Both
+     * sides exchange buffers through a single atomic index swap, so neither ever blocks,
+     * waits for the other or copies a value: publish() and update() are wait-free. The
+     * reader may skip versions but always sees a complete one.
+     *
+     * The writer thread may only call write_buffer(), publish() and write(); the reader
+     * thread may only call update(), read(), latest() and has_update().
+     *
+     * @tparam T The type of the value.
+     */
+    template<typename T>
+    class TripleBuffer {
+        static constexpr std::uint8_t index_mask = 3;
+        static constexpr std::uint8_t fresh = 4; ///< Set in middle while it holds a version the reader has not taken.
+
+        struct alignas(64) Slot {
+            T value;
+        };
+
+        Slot buffers[3];
+        alignas(64) std::atomic<std::uint8_t> middle{1 | fresh}; ///< The buffer between the two sides, plus the fresh bit.
+        alignas(64) std::uint8_t back = 0; ///< Owned by the writer.
+        alignas(64) std::uint8_t front = 2; ///< Owned by the reader.
+
+    public:
+        /**
+         * @brief Constructs a triple buffer whose three buffers hold copies of an initial value.
+         *
+         * The initial value counts as published.
+         *
+         * @param initial The initial value.
+         */
+        explicit TripleBuffer(const T &initial = T()) : buffers{{initial}, {initial}, {initial}} {}
+
+        TripleBuffer(const TripleBuffer &) = delete;
+
+        TripleBuffer &operator=(const TripleBuffer &) = delete;
+
+        /**
+         * @brief Returns the buffer the writer fills next. Writer only.
+         *
+         * The buffer holds an older version, not necessarily the last published one, so
+         * the writer must overwrite everything it wants to publish.
+         */
+        T &write_buffer() noexcept {
+            return buffers[back].value;
+        }
+
+        /**
+         * @brief Publishes the write buffer and takes a free one in its place. Writer only; wait-free.
+         */
+        void publish() noexcept {
+            back = middle.exchange(static_cast<std::uint8_t>(back | fresh), std::memory_order_acq_rel) & index_mask;
+        }
+
+        /**
+         * @brief Copies a value into the write buffer and publishes it. Writer only.
+         *
+         * @param value The value to publish.
+         */
+        void write(const T &value) {
+            write_buffer() = value;
+            publish();
+        }
+
+        /**
+         * @brief Checks whether a version newer than the one being read has been published. Reader only.
+         */
+        bool has_update() const noexcept {
+            return middle.load(std::memory_order_relaxed) & fresh;
+        }
+
+        /**
+         * @brief Switches the reader to the newest published version. Reader only; wait-free.
+         *
+         * @return true if a newer version was taken, false if the reader already had the newest.
+         */
+        bool update() noexcept {
+            if (!has_update()) return false;
+            front = middle.exchange(front, std::memory_order_acq_rel) & index_mask;
+            return true;
+        }
+
+        /**
+         * @brief Returns the version the reader holds, without checking for a newer one. Reader only.
+         */
+        const T &read() const noexcept {
+            return buffers[front].value;
+        }
+
+        /**
+         * @brief Switches to the newest published version and returns it. Reader only.
+         */
+        const T &latest() noexcept {
+            update();
+            return read();
+        }
+    };
+} // DS
+
+#endif //TRIPLEBUFFER_H
@@ -0,0 +1,312 @@
+#ifndef UNIONFIND_H
+#define UNIONFIND_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace DS {
+    /**
+     * @brief A disjoint-set forest with union by size and path halving.
+     *
+     * Parents and sizes live in two flat arrays indexed by element. Any sequence of m
+     * operations on n elements runs in O(m α(n)), which is linear for every practical n.
+     *
+     * @tparam Index The unsigned integer type used for element ids.
+     */
+    template<typename Index = std::uint32_t>
+    class UnionFind {
+        std::vector<Index> parent;
+        std::vector<Index> sizes; ///< Size of each tree; only meaningful for roots.
+        std::size_t components;
+
+        void check(const Index element) const {
+            if (element >= parent.size()) throw std::out_of_range("Element out of bounds");
+        }
+
+        Index find_unchecked(Index element) {
+            // Path halving: point every other node on the path at its grandparent.
+            while (parent[element] != element) {
+                parent[element] = parent[parent[element]];
+                element = parent[element];
+            }
+            return element;
+        }
+
+        bool unite_unchecked(Index a, Index b) {
+            a = find_unchecked(a);
+            b = find_unchecked(b);
+            if (a == b) return false;
+
+            if (sizes[a] < sizes[b]) std::swap(a, b);
+            parent[b] = a;
+            sizes[a] += sizes[b];
+            --components;
+            return true;
+        }
+
+    public:
+        /**
+         * @brief Constructs n singleton sets {0}, {1}, ..., {n - 1}.
+         * @param n The number of elements.
+         */
+        explicit UnionFind(const std::size_t n = 0) : parent(n), sizes(n, 1), components(n) {
+            for (std::size_t i = 0; i < n; ++i) parent[i] = static_cast<Index>(i);
+        }
+
+        /**
+         * @brief Returns the number of elements.
+         */
+        std::size_t size() const noexcept {
+            return parent.size();
+        }
+
+        /**
+         * @brief Returns the number of disjoint sets.
+         */
+        std::size_t component_count() const noexcept {
+            return components;
+        }
+
+        /**
+         * @brief Returns the representative of the set containing an element.
+         * @param element The element.
+         * @throws std::out_of_range If the element is out of bounds.
+         */
+        Index find(const Index element) {
+            check(element);
+            return find_unchecked(element);
+        }
+
+        /**
+         * @brief Merges the sets containing two elements.
+         * @return true if the sets were merged, false if the elements were already in the same set.
+         * @throws std::out_of_range If either element is out of bounds.
+         */
+        bool unite(const Index a, const Index b) {
+            check(a);
+            check(b);
+            return unite_unchecked(a, b);
+        }
+
+        /**
+         * @brief Merges the endpoints of every edge of an edge list.
+         *
+         * @param from The first endpoint of each edge.
+         * @param to The second endpoint of each edge.
+         * @param count The number of edges.
+         * @return The number of merges performed.
+         * @throws std::out_of_range If an endpoint is out of bounds; earlier edges stay merged.
+         */
+        std::size_t unite_all(const Index *from, const Index *to, const std::size_t count) {
+            std::size_t merged = 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                check(from[i]);
+                check(to[i]);
+                merged += unite_unchecked(from[i], to[i]);
+            }
+            return merged;
+        }
+
+        /**
+         * @brief Checks whether two elements are in the same set.
+         * @throws std::out_of_range If either element is out of bounds.
+         */
+        bool connected(const Index a, const Index b) {
+            return find(a) == find(b);
+        }
+
+        /**
+         * @brief Returns the number of elements in the set containing an element.
+         * @throws std::out_of_range If the element is out of bounds.
+         */
+        std::size_t set_size(const Index element) {
+            return sizes[find(element)];
+        }
+
+        /**
+         * @brief Returns the representative of every element, fully compressing all paths.
+         * @return labels[i] is the representative of element i.
+         */
+        std::vector<Index> labels() {
+            std::vector<Index> result(parent.size());
+            for (std::size_t i = 0; i < parent.size(); ++i) {
+                result[i] = find_unchecked(static_cast<Index>(i));
+            }
+            return result;
+        }
+    };
+
+    /**
+     * @brief A lock-free disjoint-set forest for parallel union and find.
+     *
+     * Roots are linked with a single compare-and-swap on the parent array, always from
+     * the larger id to the smaller one, so concurrent links can never form a cycle and
+     * every set is represented by its smallest element. find() halves paths with a CAS
+     * that is allowed to fail, so readers never block each other.
+     *
+     * Union by size is not used because the size and the parent of a root cannot be
+     * updated together with one CAS; linking by id keeps trees shallow in practice
+     * together with path halving.
+     *
+     * @tparam Index The unsigned integer type used for element ids.
+     */
+    template<typename Index = std::uint32_t>
+    class ConcurrentUnionFind {
+        std::unique_ptr<std::atomic<Index>[]> parent;
+        std::size_t n;
+
+        void check(const Index element) const {
+            if (element >= n) throw std::out_of_range("Element out of bounds");
+        }
+
+        Index find_unchecked(Index element) const {
+            for (;;) {
+                Index up = parent[element].load(std::memory_order_acquire);
+                if (up == element) return element;
+
+                const Index grand = parent[up].load(std::memory_order_acquire);
+                if (up != grand) {
+                    parent[element].compare_exchange_weak(up, grand, std::memory_order_acq_rel,
+                                                          std::memory_order_relaxed);
+                }
+                element = grand;
+            }
+        }
+
+        bool unite_unchecked(Index a, Index b) {
+            for (;;) {
+                a = find_unchecked(a);
+                b = find_unchecked(b);
+                if (a == b) return false;
+                if (a < b) std::swap(a, b);
+
+                // a is the larger root: link it below b, unless someone linked it meanwhile.
+                Index expected = a;
+                if (parent[a].compare_exchange_strong(expected, b, std::memory_order_acq_rel)) return true;
+            }
+        }
+
+    public:
+        /**
+         * @brief Constructs n singleton sets {0}, {1}, ..., {n - 1}.
+         * @param n The number of elements.
+         */
+        explicit ConcurrentUnionFind(const std::size_t n = 0) : parent(new std::atomic<Index>[n]), n(n) {
+            for (std::size_t i = 0; i < n; ++i) parent[i].store(static_cast<Index>(i), std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Returns the number of elements.
+         */
+        std::size_t size() const noexcept {
+            return n;
+        }
+
+        /**
+         * @brief Returns the smallest element of the set containing an element.
+         * @throws std::out_of_range If the element is out of bounds.
+         */
+        Index find(const Index element) const {
+            check(element);
+            return find_unchecked(element);
+        }
+
+        /**
+         * @brief Merges the sets containing two elements. Safe to call from many threads.
+         * @return true if this call merged the sets, false if they were already merged.
+         * @throws std::out_of_range If either element is out of bounds.
+         */
+        bool unite(const Index a, const Index b) {
+            check(a);
+            check(b);
+            return unite_unchecked(a, b);
+        }
+
+        /**
+         * @brief Checks whether two elements are in the same set.
+         *
+         * The answer is exact at some point during the call: a concurrent unite() may
+         * connect the elements right after false is returned.
+         *
+         * @throws std::out_of_range If either element is out of bounds.
+         */
+        bool connected(Index a, Index b) const {
+            check(a);
+            check(b);
+
+            for (;;) {
+                a = find_unchecked(a);
+                b = find_unchecked(b);
+                if (a == b) return true;
+                // If a is still a root, a and b were in different sets when b's root was read.
+                if (parent[a].load(std::memory_order_acquire) == a) return false;
+            }
+        }
+
+        /**
+         * @brief Merges the endpoints of every edge of an edge list using several threads.
+         *
+         * @param from The first endpoint of each edge.
+         * @param to The second endpoint of each edge.
+         * @param count The number of edges.
+         * @param threads The number of worker threads; 0 uses std::thread::hardware_concurrency().
+         * @return The number of merges performed.
+         * @throws std::out_of_range If an endpoint is out of bounds; no edge is merged in that case.
+         */
+        std::size_t unite_all(const Index *from, const Index *to, const std::size_t count, unsigned threads = 0) {
+            for (std::size_t i = 0; i < count; ++i) {
+                check(from[i]);
+                check(to[i]);
+            }
+
+            if (threads == 0) threads = std::thread::hardware_concurrency();
+            if (threads == 0) threads = 1;
+
+            std::vector<std::thread> workers;
+            std::vector<std::size_t> merged(threads, 0);
+            const std::size_t chunk = (count + threads - 1) / threads;
+
+            for (unsigned t = 0; t < threads; ++t) {
+                workers.emplace_back([this, from, to, count, chunk, t, &merged] {
+                    const std::size_t begin = t * chunk;
+                    const std::size_t end = begin + chunk < count ? begin + chunk : count;
+                    std::size_t local = 0;
+                    for (std::size_t i = begin; i < end; ++i) local += unite_unchecked(from[i], to[i]);
+                    merged[t] = local;
+                });
+            }
+
+            std::size_t total = 0;
+            for (unsigned t = 0; t < threads; ++t) {
+                workers[t].join();
+                total += merged[t];
+            }
+            return total;
+        }
+
+        /**
+         * @brief Returns the component label (smallest element) of every element.
+         *
+         * Must not run concurrently with unite().
+         *
+         * @return labels[i] is the smallest element of the set containing i.
+         */
+        std::vector<Index> labels() const {
+            std::vector<Index> result(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                // Roots have smaller ids than their descendants, so parents are already final.
+                const Index up = parent[i].load(std::memory_order_relaxed);
+                result[i] = up == i ? static_cast<Index>(i) : result[up];
+            }
+            return result;
+        }
+    };
+} // DS
+
+#endif //UNIONFIND_H
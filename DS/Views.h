@@ -0,0 +1,631 @@
+#ifndef VIEWS_H
+#define VIEWS_H
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "Array.h"
+#include "DoublyLinkedList/DLinkedList.h"
+
+namespace DS {
+    /**
+     * @brief Lazy, composable views over DS containers.
+     *
+     * A view refers to a container, or to another view, and produces its elements on
+     * demand while it is iterated. Views are cheap to copy, never allocate, and a
+     * pipeline of them runs in a single pass over the source:
+     *
+     * @code
+     * DS::Array<int> result;
+     * DS::collect(DS::view(array) | DS::filter(is_even) | DS::transform(square) | DS::take(10), result);
+     * @endcode
+     *
+     * A view does not own its source: the container must outlive it and must not be
+     * modified while it is iterated. Every view has begin() and end() and can be used in
+     * a range-based for loop; views whose length is known without iterating have
+     * sized == true and a size() function.
+     */
+    struct ViewBase {};
+
+    template<typename V>
+    constexpr bool is_view = std::is_base_of<ViewBase, std::decay_t<V> >::value;
+
+    /**
+     * @brief The elements between two iterators.
+     */
+    template<typename Iterator>
+    class RangeView : public ViewBase {
+        Iterator first;
+        Iterator last;
+        std::size_t count;
+
+    public:
+        static constexpr bool sized = true;
+
+        RangeView(Iterator first, Iterator last, const std::size_t count) : first(first), last(last), count(count) {}
+
+        Iterator begin() const {
+            return first;
+        }
+
+        Iterator end() const {
+            return last;
+        }
+
+        std::size_t size() const {
+            return count;
+        }
+    };
+
+    template<typename T>
+    RangeView<const T *> view(const Array<T> &array) {
+        return {array.begin(), array.end(), static_cast<std::size_t>(array.size())};
+    }
+
+    template<typename T>
+    RangeView<typename DLinkedList<T>::ConstIterator> view(const DLinkedList<T> &list) {
+        return {list.begin(), list.end(), list.get_size()};
+    }
+
+    /**
+     * @brief The elements of a view for which a predicate holds.
+     */
+    template<typename V, typename Predicate>
+    class FilterView : public ViewBase {
+        using Base = decltype(std::declval<const V &>().begin());
+
+        V base;
+        Predicate predicate;
+
+    public:
+        static constexpr bool sized = false;
+
+        class Iterator {
+            Base current;
+            Base last;
+            const Predicate *predicate;
+
+            void skip() {
+                while (current != last && !(*predicate)(*current)) ++current;
+            }
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = typename std::iterator_traits<Base>::value_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = typename std::iterator_traits<Base>::pointer;
+            using reference = typename std::iterator_traits<Base>::reference;
+
+            Iterator(Base current, Base last, const Predicate *predicate)
+                : current(current), last(last), predicate(predicate) {
+                skip();
+            }
+
+            decltype(auto) operator*() const {
+                return *current;
+            }
+
+            Iterator &operator++() {
+                ++current;
+                skip();
+                return *this;
+            }
+
+            Iterator operator++(int) {
+                Iterator previous = *this;
+                ++*this;
+                return previous;
+            }
+
+            bool operator==(const Iterator &other) const {
+                return current == other.current;
+            }
+
+            bool operator!=(const Iterator &other) const {
+                return current != other.current;
+            }
+        };
+
+        FilterView(const V &base, const Predicate &predicate) : base(base), predicate(predicate) {}
+
+        Iterator begin() const {
+            return Iterator(base.begin(), base.end(), &predicate);
+        }
+
+        Iterator end() const {
+            return Iterator(base.end(), base.end(), &predicate);
+        }
+    };
+
+    /**
+     * @brief The results of a function applied to each element of a view.
+     */
+    template<typename V, typename Function>
+    class TransformView : public ViewBase {
+        using Base = decltype(std::declval<const V &>().begin());
+
+        V base;
+        Function function;
+
+    public:
+        static constexpr bool sized = V::sized;
+
+        class Iterator {
+            Base current;
+            const Function *function;
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using reference = std::invoke_result_t<const Function &, typename std::iterator_traits<Base>::reference>;
+            using value_type = std::remove_cv_t<std::remove_reference_t<reference> >;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void; ///< The function may return a temporary.
+
+            Iterator(Base current, const Function *function) : current(current), function(function) {}
+
+            reference operator*() const {
+                return (*function)(*current);
+            }
+
+            Iterator &operator++() {
+                ++current;
+                return *this;
+            }
+
+            Iterator operator++(int) {
+                Iterator previous = *this;
+                ++current;
+                return previous;
+            }
+
+            bool operator==(const Iterator &other) const {
+                return current == other.current;
+            }
+
+            bool operator!=(const Iterator &other) const {
+                return current != other.current;
+            }
+        };
+
+        TransformView(const V &base, const Function &function) : base(base), function(function) {}
+
+        Iterator begin() const {
+            return Iterator(base.begin(), &function);
+        }
+
+        Iterator end() const {
+            return Iterator(base.end(), &function);
+        }
+
+        std::size_t size() const {
+            return base.size();
+        }
+    };
+
+    /**
+     * @brief The first count elements of a view, or all of them if there are fewer.
+     */
+    template<typename V>
+    class TakeView : public ViewBase {
+        using Base = decltype(std::declval<const V &>().begin());
+
+        V base;
+        std::size_t count;
+
+    public:
+        static constexpr bool sized = V::sized;
+
+        class Iterator {
+            Base current;
+            std::size_t remaining;
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = typename std::iterator_traits<Base>::value_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = typename std::iterator_traits<Base>::pointer;
+            using reference = typename std::iterator_traits<Base>::reference;
+
+            Iterator(Base current, const std::size_t remaining) : current(current), remaining(remaining) {}
+
+            decltype(auto) operator*() const {
+                return *current;
+            }
+
+            /**
+             * @brief Leaves the base alone after the last element, so a lazy base such as a
+             *        FilterView does not search past it.
+             */
+            Iterator &operator++() {
+                if (--remaining != 0) ++current;
+                return *this;
+            }
+
+            Iterator operator++(int) {
+                Iterator previous = *this;
+                ++*this;
+                return previous;
+            }
+
+            bool operator==(const Iterator &other) const {
+                return (remaining == 0 && other.remaining == 0) || current == other.current;
+            }
+
+            bool operator!=(const Iterator &other) const {
+                return !(*this == other);
+            }
+        };
+
+        TakeView(const V &base, const std::size_t count) : base(base), count(count) {}
+
+        Iterator begin() const {
+            return Iterator(base.begin(), count);
+        }
+
+        Iterator end() const {
+            return Iterator(base.end(), 0);
+        }
+
+        std::size_t size() const {
+            return base.size() < count ? base.size() : count;
+        }
+    };
+
+    /**
+     * @brief A view without its first count elements.
+     */
+    template<typename V>
+    class DropView : public ViewBase {
+        using Base = decltype(std::declval<const V &>().begin());
+
+        V base;
+        std::size_t count;
+
+    public:
+        static constexpr bool sized = V::sized;
+
+        DropView(const V &base, const std::size_t count) : base(base), count(count) {}
+
+        Base begin() const {
+            Base current = base.begin();
+            const Base last = base.end();
+            if constexpr (std::is_pointer<Base>::value) {
+                const auto available = static_cast<std::size_t>(last - current);
+                return current + (count < available ? count : available);
+            }
+            for (std::size_t skipped = 0; skipped < count && current != last; ++skipped) ++current;
+            return current;
+        }
+
+        Base end() const {
+            return base.end();
+        }
+
+        std::size_t size() const {
+            return base.size() > count ? base.size() - count : 0;
+        }
+    };
+
+    /**
+     * @brief Pairs of corresponding elements of two views, as long as the shorter one.
+     */
+    template<typename V1, typename V2>
+    class ZipView : public ViewBase {
+        using Base1 = decltype(std::declval<const V1 &>().begin());
+        using Base2 = decltype(std::declval<const V2 &>().begin());
+
+        V1 first;
+        V2 second;
+
+    public:
+        static constexpr bool sized = V1::sized && V2::sized;
+
+        class Iterator {
+            Base1 current1;
+            Base2 current2;
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using reference = std::pair<typename std::iterator_traits<Base1>::reference,
+                                        typename std::iterator_traits<Base2>::reference>;
+            using value_type = reference;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void; ///< Elements are pairs built on access.
+
+            Iterator(Base1 current1, Base2 current2) : current1(current1), current2(current2) {}
+
+            reference operator*() const {
+                return {*current1, *current2};
+            }
+
+            Iterator &operator++() {
+                ++current1;
+                ++current2;
+                return *this;
+            }
+
+            Iterator operator++(int) {
+                Iterator previous = *this;
+                ++*this;
+                return previous;
+            }
+
+            /**
+             * @brief Iterators are equal as soon as either side is, so iteration stops at the shorter view.
+             */
+            bool operator==(const Iterator &other) const {
+                return current1 == other.current1 || current2 == other.current2;
+            }
+
+            bool operator!=(const Iterator &other) const {
+                return !(*this == other);
+            }
+        };
+
+        ZipView(const V1 &first, const V2 &second) : first(first), second(second) {}
+
+        Iterator begin() const {
+            return Iterator(first.begin(), second.begin());
+        }
+
+        Iterator end() const {
+            return Iterator(first.end(), second.end());
+        }
+
+        std::size_t size() const {
+            return first.size() < second.size() ? first.size() : second.size();
+        }
+    };
+
+    /**
+     * @brief Consecutive, non-overlapping RangeViews of count elements of a view; the last one may be shorter.
+     */
+    template<typename V>
+    class ChunkView : public ViewBase {
+        using Base = decltype(std::declval<const V &>().begin());
+
+        V base;
+        std::size_t count;
+
+    public:
+        static constexpr bool sized = V::sized;
+
+        class Iterator {
+            Base current;
+            Base chunk_end;
+            Base last;
+            std::size_t count;
+            std::size_t length = 0; ///< The number of elements in [current, chunk_end).
+
+            void measure() {
+                chunk_end = current;
+                for (length = 0; length < count && chunk_end != last; ++length) ++chunk_end;
+            }
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = RangeView<Base>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void; ///< Chunks are built on access.
+            using reference = RangeView<Base>;
+
+            Iterator(Base current, Base last, const std::size_t count)
+                : current(current), chunk_end(current), last(last), count(count) {
+                measure();
+            }
+
+            RangeView<Base> operator*() const {
+                return {current, chunk_end, length};
+            }
+
+            Iterator &operator++() {
+                current = chunk_end;
+                measure();
+                return *this;
+            }
+
+            Iterator operator++(int) {
+                Iterator previous = *this;
+                ++*this;
+                return previous;
+            }
+
+            bool operator==(const Iterator &other) const {
+                return current == other.current;
+            }
+
+            bool operator!=(const Iterator &other) const {
+                return current != other.current;
+            }
+        };
+
+        /**
+         * @throws std::runtime_error If count is zero.
+         */
+        ChunkView(const V &base, const std::size_t count) : base(base), count(count) {
+            if (count == 0) throw std::runtime_error("Invalid chunk size");
+        }
+
+        Iterator begin() const {
+            return Iterator(base.begin(), base.end(), count);
+        }
+
+        Iterator end() const {
+            return Iterator(base.end(), base.end(), count);
+        }
+
+        std::size_t size() const {
+            return (base.size() + count - 1) / count;
+        }
+    };
+
+    /**
+     * @brief Pairs of the position, from 0, and the element of each element of a view.
+     */
+    template<typename V>
+    class EnumerateView : public ViewBase {
+        using Base = decltype(std::declval<const V &>().begin());
+
+        V base;
+
+    public:
+        static constexpr bool sized = V::sized;
+
+        class Iterator {
+            Base current;
+            std::size_t index;
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using reference = std::pair<std::size_t, typename std::iterator_traits<Base>::reference>;
+            using value_type = reference;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void; ///< Elements are pairs built on access.
+
+            Iterator(Base current, const std::size_t index) : current(current), index(index) {}
+
+            reference operator*() const {
+                return {index, *current};
+            }
+
+            Iterator &operator++() {
+                ++current;
+                ++index;
+                return *this;
+            }
+
+            Iterator operator++(int) {
+                Iterator previous = *this;
+                ++*this;
+                return previous;
+            }
+
+            bool operator==(const Iterator &other) const {
+                return current == other.current;
+            }
+
+            bool operator!=(const Iterator &other) const {
+                return current != other.current;
+            }
+        };
+
+        explicit EnumerateView(const V &base) : base(base) {}
+
+        Iterator begin() const {
+            return Iterator(base.begin(), 0);
+        }
+
+        Iterator end() const {
+            return Iterator(base.end(), 0);
+        }
+
+        std::size_t size() const {
+            return base.size();
+        }
+    };
+
+    /**
+     * @brief A pending view step, applied to a view with operator|.
+     */
+    template<typename Make>
+    struct ViewAdaptor {
+        Make make;
+    };
+
+    template<typename Make>
+    ViewAdaptor<Make> make_adaptor(Make make) {
+        return {make};
+    }
+
+    template<typename V, typename Make, typename = std::enable_if_t<is_view<V> > >
+    auto operator|(const V &view, const ViewAdaptor<Make> &adaptor) {
+        return adaptor.make(view);
+    }
+
+    template<typename Predicate>
+    auto filter(Predicate predicate) {
+        return make_adaptor([predicate](const auto &view) {
+            return FilterView<std::decay_t<decltype(view)>, Predicate>(view, predicate);
+        });
+    }
+
+    template<typename Function>
+    auto transform(Function function) {
+        return make_adaptor([function](const auto &view) {
+            return TransformView<std::decay_t<decltype(view)>, Function>(view, function);
+        });
+    }
+
+    inline auto take(const std::size_t count) {
+        return make_adaptor([count](const auto &view) {
+            return TakeView<std::decay_t<decltype(view)> >(view, count);
+        });
+    }
+
+    inline auto drop(const std::size_t count) {
+        return make_adaptor([count](const auto &view) {
+            return DropView<std::decay_t<decltype(view)> >(view, count);
+        });
+    }
+
+    inline auto chunk(const std::size_t count) {
+        return make_adaptor([count](const auto &view) {
+            return ChunkView<std::decay_t<decltype(view)> >(view, count);
+        });
+    }
+
+    inline auto enumerate() {
+        return make_adaptor([](const auto &view) {
+            return EnumerateView<std::decay_t<decltype(view)> >(view);
+        });
+    }
+
+    template<typename V1, typename V2, typename = std::enable_if_t<is_view<V1> && is_view<V2> > >
+    ZipView<V1, V2> zip(const V1 &first, const V2 &second) {
+        return {first, second};
+    }
+
+    /**
+     * @brief Pairs the elements of a view with those of another view: view | zip(other).
+     */
+    template<typename V2, typename = std::enable_if_t<is_view<V2> > >
+    auto zip(const V2 &second) {
+        return make_adaptor([second](const auto &view) {
+            return ZipView<std::decay_t<decltype(view)>, V2>(view, second);
+        });
+    }
+
+    /**
+     * @brief Appends the elements of a view to a DS::Array in one pass.
+     *
+     * When the length of the view is known, the array grows to its final capacity once
+     * before the elements are appended.
+     *
+     * @param view The view.
+     * @param array The array to append to.
+     */
+    template<typename V, typename T, typename = std::enable_if_t<is_view<V> > >
+    void collect(const V &view, Array<T> &array) {
+        if constexpr (std::decay_t<V>::sized) {
+            const int needed = array.size() + static_cast<int>(view.size());
+            if (needed > array.capacity()) array.resize(needed);
+        }
+        for (auto &&value: view) array.push_back(value);
+    }
+
+    /**
+     * @brief Appends the elements of a view to a DLinkedList in one pass.
+     *
+     * @param view The view.
+     * @param list The list to append to.
+     */
+    template<typename V, typename T, typename = std::enable_if_t<is_view<V> > >
+    void collect(const V &view, DLinkedList<T> &list) {
+        for (auto &&value: view) list.push_back(value);
+    }
+} // DS
+
+#endif //VIEWS_H
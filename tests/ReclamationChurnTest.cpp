@@ -0,0 +1,141 @@
+//
+// Thread-churn test of the memory reclamation schemes: EpochReclamation, HazardPointers and Rcu.
+//
+// Rounds of short-lived threads read a shared node through the scheme while replacing and
+// retiring it, so records are handed from exited threads to new ones and the garbage of
+// exited threads has to be adopted. Run it under AddressSanitizer (use after free, leaks)
+// and ThreadSanitizer (races):
+//
+//   g++ -std=c++17 -O1 -g -fsanitize=address,undefined -pthread -I.. ReclamationChurnTest.cpp -o churn && ./churn
+//   g++ -std=c++17 -O1 -g -fsanitize=thread -pthread -I.. ReclamationChurnTest.cpp -o churn && ./churn
+//
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "DS/EpochReclamation.h"
+#include "DS/HazardPointers.h"
+#include "DS/Rcu.h"
+
+namespace {
+    constexpr int rounds = 40;
+    constexpr int threads_per_round = 4;
+    constexpr int operations = 2000;
+
+    std::atomic<long> live{0};
+    std::atomic<long> failures{0};
+
+    struct Node {
+        std::uint64_t value;
+        std::uint64_t check; ///< ~value while the node is alive.
+
+        explicit Node(const std::uint64_t value) : value(value), check(~value) {
+            live.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        ~Node() {
+            check = 0;
+            live.fetch_sub(1, std::memory_order_relaxed);
+        }
+    };
+
+    void verify(const Node *node) {
+        if (node == nullptr || node->check != ~node->value) failures.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void expect(const bool condition, const char *message) {
+        if (!condition) {
+            std::printf("FAILED: %s\n", message);
+            failures.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Runs rounds of short-lived threads that call step(thread, i) for every operation.
+     */
+    template<typename Step>
+    void churn(Step step) {
+        for (int round = 0; round < rounds; ++round) {
+            std::vector<std::thread> threads;
+            for (int t = 0; t < threads_per_round; ++t) {
+                threads.emplace_back([&step, t] {
+                    for (int i = 0; i < operations; ++i) step(t, i);
+                });
+            }
+            for (std::thread &thread: threads) thread.join();
+        }
+    }
+
+    void test_epoch_reclamation() {
+        std::atomic<Node *> shared{new Node(0)};
+
+        churn([&shared](const int t, const int i) {
+            if ((i + t) % 4 == 0) {
+                Node *old = shared.exchange(new Node(static_cast<std::uint64_t>(i)), std::memory_order_acq_rel);
+                DS::EpochReclamation::retire(old);
+            } else {
+                DS::EpochReclamation::Guard guard;
+                verify(shared.load(std::memory_order_acquire));
+            }
+        });
+
+        DS::EpochReclamation::retire(shared.load());
+        // Enough retirements to advance the epoch several times and free the adopted orphans.
+        for (int i = 0; i < 1024; ++i) DS::EpochReclamation::retire(new Node(0));
+        expect(live.load() < 256, "EpochReclamation frees the garbage of exited threads");
+    }
+
+    void test_hazard_pointers() {
+        std::atomic<Node *> shared{new Node(0)};
+
+        churn([&shared](const int t, const int i) {
+            if ((i + t) % 4 == 0) {
+                Node *old = shared.exchange(new Node(static_cast<std::uint64_t>(i)), std::memory_order_acq_rel);
+                DS::HazardPointers::retire(old);
+            } else {
+                DS::HazardPointers::HazardPointer hazard;
+                verify(hazard.protect(shared));
+            }
+        });
+
+        DS::HazardPointers::retire(shared.load());
+        DS::HazardPointers::reclaim();
+        expect(live.load() == 0, "HazardPointers frees the garbage of exited threads");
+    }
+
+    void test_rcu() {
+        {
+            DS::RcuPointer<Node> shared(std::make_unique<Node>(0));
+
+            churn([&shared](const int t, const int i) {
+                // Every publish waits for a grace period, so writes are rarer here.
+                if ((i + t) % 64 == 0) {
+                    shared.publish(std::make_unique<Node>(static_cast<std::uint64_t>(i)));
+                } else {
+                    DS::Rcu::ReadGuard guard;
+                    verify(shared.read());
+                }
+            });
+
+            expect(live.load() == 1, "RcuPointer frees every replaced version");
+        }
+        expect(live.load() == 0, "RcuPointer frees its last version");
+    }
+}
+
+int main() {
+    test_hazard_pointers();
+    test_rcu();
+    test_epoch_reclamation();
+
+    if (failures.load() != 0) {
+        std::printf("%ld failures\n", failures.load());
+        return 1;
+    }
+    std::printf("All reclamation churn tests passed\n");
+    return 0;
+}